@@ -5,8 +5,12 @@
  */
 
 #include "board.h"
+#include "codec_eq.h"
+#include "controls.h"
+#include "conversions.h"
 #include <halm/delay.h>
 #include <halm/wq.h>
+#include <string.h>
 /*----------------------------------------------------------------------------*/
 static void panic(struct Pin);
 /*----------------------------------------------------------------------------*/
@@ -45,38 +49,89 @@ void appBoardInit(struct Board *board)
   board->debug.serial = NULL;
 #endif
 
-  board->chronoPackage = boardSetupChronoPackage();
   board->ampPackage = boardSetupAmpPackage();
   board->adcPackage = boardSetupAdcPackage();
-  board->buttonPackage = boardSetupButtonPackage(board->chronoPackage.factory);
-  board->controlPackage = boardSetupControlPackage(
-      board->chronoPackage.factory);
+  board->controlPackage = boardSetupControlPackage();
+
+  if (BOARD_ACTIVE_MODE)
+  {
+    /* Buttons and the timer factory are used only in the active mode */
+    board->chronoPackage = boardSetupChronoPackage();
+    board->buttonPackage =
+        boardSetupButtonPackage(board->chronoPackage.factory);
+  }
+  else
+  {
+    /* Only the load timer of the debug output is needed */
+    board->chronoPackage.base = NULL;
+    board->chronoPackage.factory = NULL;
+    board->chronoPackage.load = boardMakeLoadTimer();
+    memset(&board->buttonPackage, 0, sizeof(board->buttonPackage));
+  }
 
   /* Initialize Deep-Sleep wake-up logic */
   board->system.wakeup = boardMakeWakeupInt();
 
+#ifdef ENABLE_ATTENTION
+  /* Attention line is released until the slave mode requests attention */
+  board->system.attention = pinInit(BOARD_ATTENTION_PIN);
+  pinInput(board->system.attention);
+#else
+  board->system.attention = pinStub();
+#endif
+
   board->indication.active = 0;
   board->indication.blink = 0;
+  board->indication.output = 0;
   board->indication.state = 0;
 
   board->config.memory = boardMakeMemory();
   board->config.mode = MODE_NONE;
+  board->config.eq = CODEC_EQ_FLAT;
 
-  board->event.codec = false;
-  board->event.read = false;
-  board->event.show = false;
-  board->event.slave = false;
-  board->event.suspend = false;
+  board->event.pending = 0;
+  board->event.queued = false;
 
+  board->schedule.period = 0;
+  board->schedule.check = 0;
+  board->schedule.poll = 0;
+  board->schedule.recovery = 0;
+  board->schedule.hold = 0;
+
+  board->system.storage = STORAGE_NONE;
+  board->system.stored = STORAGE_NONE;
+  board->system.fault = 0;
+  board->system.cause = 0;
+  board->system.errors = 0;
+  board->system.quiet = 0;
   board->system.retries = 0;
   board->system.slave = NULL;
   board->system.sw = 0;
   board->system.timeout = 0;
   board->system.autosuspend = false;
   board->system.powered = false;
+  board->system.sampling = false;
+  supplyMonitorInit(&board->system.supply,
+      VOLTAGE_TO_SAMPLE(VOLTAGE_THRESHOLD),
+      VOLTAGE_TO_SAMPLE(VOLTAGE_HYSTERESIS));
+  board->system.failed = false;
+  board->system.reset = false;
+
+  board->telemetry.updates = 0;
+  board->telemetry.uptime = 0;
+  board->telemetry.writes = 0;
+  board->telemetry.failures = 0;
+  board->telemetry.rejected = 0;
+  board->telemetry.watermark = 0;
+  board->telemetry.recoveries = 0;
+  board->telemetry.recovery = 0;
 
   board->debug.idle = 0;
   board->debug.loops = 0;
+  board->debug.position = 0;
+  board->debug.samples = 0;
+  board->debug.calibration = 0;
+  board->debug.busy = false;
 }
 /*----------------------------------------------------------------------------*/
 int appBoardStart(struct Board *)
@@ -8,14 +8,59 @@
 #define BOARD_AUDIOBOARD_V1_APPLICATIONS_ACTIVE_BOARD_H_
 /*----------------------------------------------------------------------------*/
 #include "board_shared.h"
+#include "controls.h"
+#include "settings.h"
+#include "slave.h"
+#include "supply.h"
 #include <dpm/audio/tlv320aic3x.h>
 #include <halm/pin.h>
 /*----------------------------------------------------------------------------*/
+/* Number of CPU load samples in the sliding window of the debug output */
+#define LOAD_WINDOW_SIZE 8
+
+/* Modes supported by the image, fixed switches leave only one of them */
+#ifdef CONFIG_OVERRIDE_SW
+#  define BOARD_ACTIVE_MODE (((CONFIG_OVERRIDE_SW) & SW_ACTIVE) != 0)
+#  define BOARD_SLAVE_MODE  (((CONFIG_OVERRIDE_SW) & SW_ACTIVE) == 0)
+#else
+#  define BOARD_ACTIVE_MODE true
+#  define BOARD_SLAVE_MODE  true
+#endif
+
 enum [[gnu::packed]] VolumeControlMode
 {
   MODE_NONE,
   MODE_MIC,
-  MODE_SPK
+  MODE_SPK,
+  /* Filter preset is selected with volume buttons */
+  MODE_EQ
+};
+
+/* Flash operations of the slave mode */
+enum [[gnu::packed]] StorageOperation
+{
+  STORAGE_NONE,
+  STORAGE_CONFIG,
+  STORAGE_PRESET
+};
+
+/* Events are handled by the dispatcher in the order of declaration */
+enum
+{
+  EVENT_SLAVE   = 0x0001,
+  EVENT_CLOCK   = 0x0002,
+  EVENT_EQ      = 0x0004,
+  EVENT_MIC     = 0x0008,
+  EVENT_SPK     = 0x0010,
+  EVENT_VOLUME  = 0x0020,
+  /* Switch poll and LED update are merged into one control bus transfer */
+  EVENT_SWITCH  = 0x0040,
+  EVENT_LED     = 0x0080,
+  EVENT_DEBUG   = 0x0100,
+  EVENT_TRACE   = 0x0200,
+  EVENT_PROFILE = 0x0400,
+  EVENT_STORAGE = 0x0800,
+  EVENT_SUSPEND = 0x1000
 };
 
 struct Board
@@ -39,22 +84,39 @@ struct Board
     enum AIC3xPath outputPath;
     uint8_t inputLevel;
     uint8_t outputLevel;
+    /* Selected filter preset of the codec */
+    uint8_t eq;
   } config;
 
   struct
   {
-    bool codec;
-    bool read;
-    bool show;
-    bool slave;
-    bool suspend;
+    /* Events to be handled by the dispatcher */
+    uint16_t pending;
+    /* Dispatcher task is in the work queue */
+    bool queued;
   } event;
 
+  struct
+  {
+    /* Interval between control timer events in control ticks */
+    uint8_t period;
+    /* Control ticks left until the codec check */
+    uint8_t check;
+    /* Control ticks left until the switch poll */
+    uint8_t poll;
+    /* Control ticks left until the codec recovery attempt or zero */
+    uint8_t recovery;
+    /* Control ticks left until the SPK button press becomes long or zero */
+    uint8_t hold;
+  } schedule;
+
   struct
   {
     struct Pin red;
     uint8_t active;
     uint8_t blink;
+    /* Last value written to the LED register */
+    uint8_t output;
     uint8_t state;
   } indication;
 
@@ -63,8 +125,30 @@ struct Board
     struct Interface *slave;
     struct Interrupt *wakeup;
     struct Watchdog *watchdog;
+    /* Open-drain attention line, stub when disabled */
+    struct Pin attention;
+
+    /* Uptime of the first bus error of the current recovery */
+    uint32_t fault;
 
-    /* Bus retries */
+    /* Last applied state of the slave registers */
+    struct SlaveRegOverlay shadow;
+    /* Filter of the supply voltage measurements */
+    struct SupplyMonitor supply;
+    /* Settings and presets are written to flash in separate steps */
+    struct SettingsWriter writer;
+    /* Flash operation in progress */
+    enum StorageOperation storage;
+    /* Finished flash operation to be reported to the host */
+    enum StorageOperation stored;
+
+    /* Attention causes not acknowledged by the host */
+    uint8_t cause;
+    /* Recent codec bus errors, one is forgotten each check period */
+    uint8_t errors;
+    /* Check periods without codec bus errors */
+    uint8_t quiet;
+    /* Failed codec bus operations since the last successful one */
     uint8_t retries;
     /* Current switch state */
     uint8_t sw;
@@ -74,14 +158,51 @@ struct Board
     bool autosuspend;
     /* External 5V power supply is ready */
     bool powered;
+    /* ADC is triggered at the fast rate */
+    bool sampling;
+    /* Last flash operation failed */
+    bool failed;
+    /* Codec is configured by the driver after a reset */
+    bool reset;
   } system;
 
+  struct
+  {
+    /* Slave register updates handled */
+    uint32_t updates;
+    /* Time since startup in control ticks */
+    uint32_t uptime;
+    /* Records written to flash */
+    uint16_t writes;
+    /* Failed flash operations */
+    uint16_t failures;
+    /* Tasks rejected by the work queue */
+    uint16_t rejected;
+    /* Maximum number of pending events */
+    uint8_t watermark;
+    /* Finished codec bus recoveries */
+    uint16_t recoveries;
+    /* Longest codec bus recovery in control ticks */
+    uint16_t recovery;
+  } telemetry;
+
   struct
   {
     struct Interface *serial;
 
+    /* Idle loop count per second, zero until the first measurement */
     uint32_t idle;
+    /* Idle loop count of the last load timer period */
     uint32_t loops;
+    /* CPU load samples in percents */
+    uint8_t load[LOAD_WINDOW_SIZE];
+    /* Position of the next sample and number of samples in the window */
+    uint8_t position;
+    uint8_t samples;
+    /* Remaining idle measurement windows, zero when finished */
+    uint8_t calibration;
+    /* Events were handled during the measurement window */
+    bool busy;
   } debug;
 };
 /*----------------------------------------------------------------------------*/
@@ -5,22 +5,17 @@
  */
 
 #include "board.h"
+#include "memory_monitor.h"
 #include "tasks.h"
 #include <stdlib.h>
 /*----------------------------------------------------------------------------*/
 int main(void)
 {
+  memoryMonitorInit();
+
   struct Board * const board = malloc(sizeof(struct Board));
   appBoardInit(board);
-
-#ifdef ENABLE_DBG
-  /*
-   * 1090897 for 12 MHz
-   *  363625 for  4 MHz
-   */
-  board->debug.idle = 1090897;
-#endif
-
   invokeStartupTask(board);
+
   return appBoardStart(board);
 }
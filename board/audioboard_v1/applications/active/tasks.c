@@ -4,45 +4,120 @@
  * Project is distributed under the terms of the GNU General Public License v3.0
  */
 
+#include "arena.h"
 #include "board.h"
+#include "codec_cache.h"
+#include "codec_clock.h"
+#include "codec_eq.h"
 #include "controls.h"
+#include "conversions.h"
+#include "memory_monitor.h"
+#include "profile.h"
 #include "settings.h"
 #include "slave.h"
 #include "tasks.h"
+#include "trace_events.h"
+#include "version.h"
 #include <halm/core/cortex/nvic.h>
 #include <halm/generic/i2c.h>
+#include <halm/generic/spi.h>
 #include <halm/generic/work_queue.h>
 #include <halm/interrupt.h>
+#include <halm/irq.h>
 #include <halm/pm.h>
 #include <halm/timer.h>
 #include <halm/watchdog.h>
+#include <xcore/helpers.h>
 #include <xcore/interface.h>
 #include <assert.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 /*----------------------------------------------------------------------------*/
 #define BUS_MAX_RETRIES       100
 #define CONTROL_UPDATE_RATE   10
 
 #define AUTO_SUSPEND_TIMEOUT  (5 * CONTROL_UPDATE_RATE)
+#define LONG_PRESS_TIME       CONTROL_UPDATE_RATE
 #define MODE_ACTIVE_TIMEOUT   (3 * CONTROL_UPDATE_RATE)
 
-#define MIN_LEVEL             0
-#define MAX_LEVEL             7
+/* Intervals of periodic control activities in control ticks */
+#define BLINK_PERIOD          (CONTROL_UPDATE_RATE / 2)
+#ifdef CONFIG_CODEC_CHECK_PERIOD
+#  define CODEC_CHECK_PERIOD  CONFIG_CODEC_CHECK_PERIOD
+#else
+#  define CODEC_CHECK_PERIOD  CONTROL_UPDATE_RATE
+#endif
+#define SWITCH_POLL_PERIOD    CONTROL_UPDATE_RATE
+/* Sample rate is selected with the board switch unless fixed at build time */
+#ifdef CONFIG_SAMPLE_RATE
+#  define SAMPLE_RATE(sw)     CONFIG_SAMPLE_RATE
+#else
+#  define SAMPLE_RATE(sw)     (((sw) & SW_SAMPLE_RATE) ? 48000 : 44100)
+#endif
+/* Watchdog period is 1 second, reload it twice as often */
+#define WATCHDOG_PERIOD       (CONTROL_UPDATE_RATE / 2)
+
+/* Idle loop rate is measured in windows of 50 ms without handled events */
+#define CALIBRATION_RATE      20
+#define CALIBRATION_ATTEMPTS  3
+
+/* ADC trigger rates near the supply threshold and far from it */
+#define ADC_RATE_FAST \
+    (CONTROL_UPDATE_RATE * 2 * CONFIG_SUPPLY_OVERSAMPLING)
+#define ADC_RATE_SLOW \
+    (CONTROL_UPDATE_RATE / 5 * CONFIG_SUPPLY_OVERSAMPLING)
+/* Filtered samples within the band are taken at the fast rate */
+#define SUPPLY_NEAR_BAND      VOLTAGE_TO_SAMPLE(VOLTAGE_HYSTERESIS * 4)
 
 #define FLASH_OFFSET          (28 * 1024)
+
+/* Codec recovery delay doubles after each failed attempt up to the limit */
+#define RECOVERY_MAX_DELAY    (5 * CONTROL_UPDATE_RATE)
+/* Failed register resynchronizations before the codec is reset */
+#define RECOVERY_RESYNC_LIMIT 3
+/* Codec bus rate is lowered when errors are closer than the check period */
+#define RATE_ERROR_LIMIT      3
+/* Codec bus rate is raised again after error-free check periods */
+#define RATE_QUIET_PERIODS    30
+
+/* Task boundaries are recorded by the tracer and by the profiler */
+#define ENTER_TASK(task) \
+    do { TRACE(TRACE_TASK_ENTER, (task)); PROFILE_ENTER(task); } while (0)
+#define EXIT_TASK(task) \
+    do { PROFILE_EXIT(task); TRACE(TRACE_TASK_EXIT, (task)); } while (0)
 /*----------------------------------------------------------------------------*/
+static uint8_t acknowledgeCauses(struct Board *, uint8_t);
 static void codecLoadDefaultSettings(struct Board *);
 static void codecLoadSettings(struct Board *, const struct Settings *);
-static inline uint8_t gainToLevel(uint8_t gain);
-static inline uint8_t levelToBar(uint8_t);
-static inline uint8_t levelToGain(uint8_t);
-static uint8_t readSwitchState(struct Board *);
+static uint8_t countEvents(uint16_t);
+static uint8_t exchangeControlBus(struct Board *, uint8_t);
+static bool elapse(uint8_t *, uint8_t);
+static bool isSlaveMode(const struct Board *);
+static uint16_t makeCodecEvents(const struct Board *);
+static uint8_t makeLedState(const struct Board *);
+static uint8_t nextControlPeriod(const struct Board *);
+static void raiseCauses(struct Board *, uint8_t);
+static void raiseCodecRate(struct Board *);
+static void raiseEvents(struct Board *, uint16_t);
+static void recoverCodec(struct Board *);
+static const struct CodecClock *selectCodecClock(const struct Board *);
+static void setAttention(struct Board *, bool);
+static void setCodecRate(struct Board *, uint32_t);
+static void setControlPeriod(struct Board *, uint8_t);
+static void setSamplingRate(struct Board *, bool);
+static void shortenControlPeriod(struct Board *);
 static void slaveLoadSettings(struct SlaveRegOverlay *,
     const struct Settings *);
+static void slaveReadRegs(struct Board *, uint32_t, void *, size_t);
 static void slaveStoreSettings(struct Settings *,
     const struct SlaveRegOverlay *);
+static void slaveUpdateWindow(struct Board *, const struct SlaveRegOverlay *);
+static void slaveWriteRegs(struct Board *, uint32_t, const void *, size_t);
+static void startStorageOperation(struct Board *, enum StorageOperation);
+static void switchOutputPath(struct Board *);
+static bool takeEvent(struct Board *, uint16_t);
+static void updateControlBus(struct Board *, bool);
+static void updateSwitchState(struct Board *, uint8_t);
 static void writeLedState(struct Board *, uint8_t);
 
 static void onBusError(void *);
@@ -56,18 +131,41 @@ static void onVolMPressed(void *);
 static void onVolPPressed(void *);
 
 static void autoSuspendTask(void *);
-static void ledUpdateTask(void *);
+static void clockUpdateTask(void *);
+static void dispatchTask(void *);
+static void eqUpdateTask(void *);
 static void micUpdateTask(void *);
 static void slaveUpdateTask(void *);
 static void spkUpdateTask(void *);
 static void startupTask(void *);
-static void switchReadTask(void *);
+static void storageUpdateTask(void *);
 static void volumeUpdateTask(void *);
 
 #ifdef ENABLE_DBG
+static void startLoadCalibration(struct Board *);
 static void debugInfoTask(void *);
 static void onLoadTimerOverflow(void *);
 #endif
+
+#ifdef ENABLE_PROFILE
+static void profileDumpTask(void *);
+#endif
+
+#ifdef ENABLE_TRACE
+static void onSerialEvent(void *);
+static void traceDumpTask(void *);
+#endif
+/*----------------------------------------------------------------------------*/
+static uint8_t acknowledgeCauses(struct Board *board, uint8_t causes)
+{
+  const IrqState state = irqSave();
+  const uint8_t pending = board->system.cause & ~causes;
+
+  board->system.cause = pending;
+  irqRestore(state);
+
+  return pending;
+}
 /*----------------------------------------------------------------------------*/
 static void codecLoadDefaultSettings(struct Board *board)
 {
@@ -90,60 +188,344 @@ static void codecLoadSettings(struct Board *board,
   board->config.outputPath = settings->codecOutputPath;
 }
 /*----------------------------------------------------------------------------*/
-static inline uint8_t gainToLevel(uint8_t gain)
+static uint8_t countEvents(uint16_t events)
 {
-  return gain * MAX_LEVEL / 255;
-}
-/*----------------------------------------------------------------------------*/
-static inline uint8_t levelToBar(uint8_t level)
-{
-  uint8_t result = 0;
+  uint8_t count = 0;
 
-  switch ((level + 1) / 2)
+  while (events)
   {
-    case 4:
-      result |= 0x01;
-      [[fallthrough]];
-    case 3:
-      result |= 0x02;
-      [[fallthrough]];
-    case 2:
-      result |= 0x04;
-      [[fallthrough]];
-    case 1:
-      result |= 0x08;
-      break;
-
-    default:
-      break;
+    events &= events - 1;
+    ++count;
   }
 
-  return result;
+  return count;
 }
 /*----------------------------------------------------------------------------*/
-static inline uint8_t levelToGain(uint8_t level)
+static bool elapse(uint8_t *counter, uint8_t elapsed)
 {
-  return level * 255 / MAX_LEVEL;
+  if (*counter <= elapsed)
+  {
+    *counter = 0;
+    return true;
+  }
+  else
+  {
+    *counter -= elapsed;
+    return false;
+  }
 }
 /*----------------------------------------------------------------------------*/
-static uint8_t readSwitchState(struct Board *board)
+static uint8_t exchangeControlBus(struct Board *board, uint8_t leds)
 {
-  uint8_t state;
+  uint8_t state = leds;
+
+  pinReset(board->controlPackage.csW);
 
 #ifdef CONFIG_OVERRIDE_SW
-  (void)board;
+  ifWrite(board->controlPackage.spi, &state, sizeof(state));
   state = CONFIG_OVERRIDE_SW;
 #else
+  /* Latch switch states and enable the output of the input register */
   pinReset(board->controlPackage.enR);
   pinSet(board->controlPackage.csR);
   pinSet(board->controlPackage.enR);
+
+  /* LED states are shifted out while switch states are shifted in */
   ifRead(board->controlPackage.spi, &state, sizeof(state));
   pinReset(board->controlPackage.csR);
 #endif
 
+  pinSet(board->controlPackage.csW);
+  board->indication.output = leds;
+
   return state & SW_MASK;
 }
 /*----------------------------------------------------------------------------*/
+static bool isSlaveMode(const struct Board *board)
+{
+  /* Decision is folded at compile time when the image supports one mode */
+  if (!BOARD_SLAVE_MODE)
+    return false;
+  if (!BOARD_ACTIVE_MODE)
+    return true;
+
+  return board->system.slave != NULL;
+}
+/*----------------------------------------------------------------------------*/
+static uint16_t makeCodecEvents(const struct Board *board)
+{
+  uint16_t events = 0;
+
+  if (board->codecPackage.clock != selectCodecClock(board))
+    events |= EVENT_CLOCK;
+  if (board->codecPackage.eq != board->config.eq)
+    events |= EVENT_EQ;
+
+  return events;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t makeLedState(const struct Board *board)
+{
+  static_assert(CODEC_EQ_COUNT <= 5, "Presets do not fit the level bar");
+
+  uint8_t value = 0;
+
+  if (!isSlaveMode(board))
+  {
+    const bool enabled = board->indication.blink < CONTROL_UPDATE_RATE / 2;
+
+    switch (board->config.mode)
+    {
+      case MODE_MIC:
+        value |= levelToBar(board->config.inputLevel);
+        break;
+
+      case MODE_SPK:
+        value |= levelToBar(board->config.outputLevel);
+        break;
+
+      case MODE_EQ:
+        /* Number of bar segments is the number of the filter preset */
+        value |= (0xF0 >> board->config.eq) & 0x0F;
+        break;
+
+      default:
+        break;
+    }
+
+    if (board->config.mode != MODE_MIC)
+    {
+      if (board->config.inputPath == BOARD_AUDIO_INPUT_PATH_A)
+        value |= 0x80;
+      else if (board->config.inputPath == BOARD_AUDIO_INPUT_PATH_B)
+        value |= 0x40;
+    }
+    else if (enabled)
+    {
+      value |= 0xC0;
+    }
+
+    if (board->config.mode != MODE_SPK && board->config.mode != MODE_EQ)
+    {
+      if (board->config.outputPath == BOARD_AUDIO_OUTPUT_PATH_A)
+        value |= 0x10;
+      else if (board->config.outputPath == BOARD_AUDIO_OUTPUT_PATH_B)
+        value |= 0x20;
+    }
+    else if (enabled)
+    {
+      value |= 0x30;
+    }
+  }
+  else
+  {
+    value = board->indication.state;
+  }
+
+  return value;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t nextControlPeriod(const struct Board *board)
+{
+  uint8_t period = board->schedule.poll;
+
+  if (BOARD_ACTIVE_MODE && board->codecPackage.codec != NULL)
+    period = MIN(period, board->schedule.check);
+
+  if (!isSlaveMode(board))
+  {
+    if (board->indication.active)
+      period = MIN(period, board->indication.active);
+
+    /* Button state is polled until release or long press */
+    if (board->schedule.hold)
+      period = MIN(period, 1);
+
+    /* Blinking bar graph is shown only in volume control modes */
+    if (board->config.mode != MODE_NONE)
+    {
+      period = MIN(period,
+          BLINK_PERIOD - board->indication.blink % BLINK_PERIOD);
+    }
+  }
+
+  if (board->schedule.recovery)
+    period = MIN(period, board->schedule.recovery);
+
+  if (board->system.autosuspend)
+    period = MIN(period, MAX(board->system.timeout, 1));
+
+  if (board->system.watchdog != NULL)
+    period = MIN(period, WATCHDOG_PERIOD);
+
+  return period;
+}
+/*----------------------------------------------------------------------------*/
+static void raiseCauses(struct Board *board, uint8_t causes)
+{
+  const IrqState state = irqSave();
+
+  board->system.cause |= causes;
+  irqRestore(state);
+
+  raiseEvents(board, EVENT_SLAVE);
+}
+/*----------------------------------------------------------------------------*/
+static void raiseCodecRate(struct Board *board)
+{
+  struct Interface * const i2c = board->codecPackage.i2c;
+  const uint32_t rate = boardPrevCodecRate(board->codecPackage.rate);
+
+  /* Rates above the one found by the startup probe are never used */
+  if (rate > board->codecPackage.limit || rate == board->codecPackage.rate)
+  {
+    board->system.quiet = 0;
+    return;
+  }
+
+  /* Rate is changed between transfers, otherwise it is retried later */
+  if (ifSetParam(i2c, IF_ACQUIRE, NULL) != E_OK)
+    return;
+
+  setCodecRate(board, rate);
+  ifSetParam(i2c, IF_RELEASE, NULL);
+
+  board->system.quiet = 0;
+}
+/*----------------------------------------------------------------------------*/
+static void raiseEvents(struct Board *board, uint16_t events)
+{
+#ifdef ENABLE_TRACE
+  /* Trace records are dumped as soon as a full line is buffered */
+  if (traceReady())
+    events |= EVENT_TRACE;
+#endif
+
+  const IrqState state = irqSave();
+  const bool enqueue = !board->event.queued
+      && (board->event.pending | events) != 0;
+
+  board->event.pending |= events;
+  if (enqueue)
+    board->event.queued = true;
+
+  /* Pending events replace separate tasks in the work queue */
+  const uint8_t depth = countEvents(board->event.pending);
+
+  if (depth > board->telemetry.watermark)
+    board->telemetry.watermark = depth;
+
+  irqRestore(state);
+
+  if (enqueue)
+  {
+    if (wqAdd(WQ_DEFAULT, dispatchTask, board) == E_OK)
+    {
+      TRACE(TRACE_TASK_QUEUED, TASK_DISPATCH);
+      PROFILE_QUEUE(TASK_DISPATCH);
+    }
+    else
+    {
+      /* Pending events are kept, dispatcher will be queued on the next tick */
+      TRACE(TRACE_TASK_REJECTED, TASK_DISPATCH);
+      ++board->telemetry.rejected;
+      board->event.queued = false;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void recoverCodec(struct Board *board)
+{
+  TRACE(TRACE_BUS_RECOVERY, board->system.retries);
+
+  if (board->system.retries <= RECOVERY_RESYNC_LIMIT)
+  {
+    /* Rewrite only the registers that differ from the expected values */
+    codecCacheResync(board->codecPackage.cache);
+    raiseEvents(board, EVENT_MIC | EVENT_SPK | EVENT_VOLUME);
+  }
+  else
+  {
+    /* Codec is reconfigured from scratch, updates are replayed when idle */
+    board->codecPackage.clock = NULL;
+    board->codecPackage.eq = CODEC_EQ_COUNT;
+    board->system.reset = true;
+    codecReset(board->codecPackage.codec);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static const struct CodecClock *selectCodecClock(const struct Board *board)
+{
+  const uint8_t sw = board->system.sw;
+  const struct CodecClock * const clock =
+      codecClockFind(SAMPLE_RATE(sw), (sw & SW_EXT_CLOCK) == 0);
+
+  assert(clock != NULL);
+  return clock;
+}
+/*----------------------------------------------------------------------------*/
+static void setAttention(struct Board *board, bool active)
+{
+  if (!pinValid(board->system.attention))
+    return;
+
+  /* Open-drain output: drive the line low or release it */
+  if (active)
+    pinOutput(board->system.attention, false);
+  else
+    pinInput(board->system.attention);
+}
+/*----------------------------------------------------------------------------*/
+static void setCodecRate(struct Board *board, uint32_t rate)
+{
+  if (rate != board->codecPackage.rate)
+  {
+    TRACE(TRACE_BUS_RATE, rate / 10000);
+
+    board->codecPackage.rate = rate;
+    ifSetParam(board->codecPackage.i2c, IF_RATE, &rate);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void setControlPeriod(struct Board *board, uint8_t period)
+{
+  struct Timer * const timer = board->controlPackage.timer;
+
+  board->schedule.period = period;
+  timerSetOverflow(timer,
+      period * timerGetFrequency(timer) / CONTROL_UPDATE_RATE);
+}
+/*----------------------------------------------------------------------------*/
+static void setSamplingRate(struct Board *board, bool fast)
+{
+  const uint32_t rate = fast ? ADC_RATE_FAST : ADC_RATE_SLOW;
+
+  board->system.sampling = fast;
+  timerSetOverflow(board->adcPackage.timer,
+      timerGetFrequency(board->adcPackage.timer) / rate);
+}
+/*----------------------------------------------------------------------------*/
+static void shortenControlPeriod(struct Board *board)
+{
+  struct Timer * const timer = board->controlPackage.timer;
+  const uint32_t tick = timerGetFrequency(timer) / CONTROL_UPDATE_RATE;
+  const IrqState state = irqSave();
+
+  /* Deadlines are counted from the previous control event */
+  const uint32_t value = timerGetValue(timer);
+  const uint8_t period = (uint8_t)MAX(nextControlPeriod(board),
+      value / tick + 1);
+
+  if (period < board->schedule.period)
+  {
+    /* Time passed since the previous event is kept in the counter */
+    setControlPeriod(board, period);
+    timerSetValue(timer, value);
+  }
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
 static void slaveLoadSettings(struct SlaveRegOverlay *overlay,
     const struct Settings *settings)
 {
@@ -183,6 +565,13 @@ static void slaveLoadSettings(struct SlaveRegOverlay *overlay,
   overlay->spk = settings->codecOutputLevel;
 }
 /*----------------------------------------------------------------------------*/
+static void slaveReadRegs(struct Board *board, uint32_t position,
+    void *buffer, size_t length)
+{
+  ifSetParam(board->system.slave, IF_POSITION, &position);
+  ifRead(board->system.slave, buffer, length);
+}
+/*----------------------------------------------------------------------------*/
 static void slaveStoreSettings(struct Settings *settings,
     const struct SlaveRegOverlay *overlay)
 {
@@ -226,17 +615,200 @@ static void slaveStoreSettings(struct Settings *settings,
   settings->codecOutputLevel = overlay->spk;
 }
 /*----------------------------------------------------------------------------*/
+static void slaveUpdateWindow(struct Board *board,
+    const struct SlaveRegOverlay *overlay)
+{
+  struct [[gnu::packed]]
+  {
+    struct SlaveWindowHeader header;
+
+    union
+    {
+      uint8_t raw[SLAVE_PAGE_SIZE];
+      struct SlaveDiagnosticPage diagnostic;
+      struct SlaveTelemetryPage telemetry;
+      struct SlaveVersionPage version;
+    };
+  } current, window;
+
+  static_assert(sizeof(struct SlaveDiagnosticPage) == SLAVE_PAGE_SIZE,
+      "Incorrect diagnostic page");
+  static_assert(sizeof(struct SlaveTelemetryPage) == SLAVE_PAGE_SIZE,
+      "Incorrect telemetry page");
+  static_assert(sizeof(struct SlaveVersionPage) == SLAVE_PAGE_SIZE,
+      "Incorrect version page");
+  static_assert(sizeof(window) == SLAVE_WINDOW_SIZE, "Incorrect window");
+
+  uint8_t page;
+
+  slaveReadRegs(board, SLAVE_REG_PAGE, &page, sizeof(page));
+  slaveReadRegs(board, SLAVE_WINDOW_BASE, &current, sizeof(current));
+  memset(&window, 0, sizeof(window));
+
+  switch (page)
+  {
+    case SLAVE_PAGE_TELEMETRY:
+      window.telemetry.voltage =
+          (uint16_t)SAMPLE_TO_VOLTAGE(board->system.supply.value);
+      window.telemetry.uptime = board->telemetry.uptime;
+      window.telemetry.status = overlay->status;
+      window.telemetry.sw = board->system.sw;
+      break;
+
+    case SLAVE_PAGE_VERSION:
+    {
+      const struct BoardVersion * const version = getBoardVersion();
+
+      window.version.hwMajor = (uint8_t)version->hw.major;
+      window.version.hwMinor = (uint8_t)version->hw.minor;
+      window.version.swMajor = (uint8_t)version->sw.major;
+      window.version.swMinor = (uint8_t)version->sw.minor;
+      window.version.revision = version->sw.revision;
+      window.version.hash = version->sw.hash;
+      window.version.timestamp = version->timestamp;
+      break;
+    }
+
+    case SLAVE_PAGE_DIAGNOSTIC:
+    {
+      struct MemoryUsage usage;
+
+      memoryMonitorGetUsage(&usage);
+
+      window.diagnostic.updates = board->telemetry.updates;
+      window.diagnostic.writes = board->telemetry.writes;
+      window.diagnostic.failures = board->telemetry.failures;
+      window.diagnostic.rejected = board->telemetry.rejected;
+      window.diagnostic.watermark = board->telemetry.watermark;
+      window.diagnostic.heap = (uint16_t)usage.heap;
+      window.diagnostic.stack = (uint16_t)usage.stack;
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  /* Header tells the host whether the window already shows the new page */
+  if (page != current.header.page
+      || memcmp(window.raw, current.raw, sizeof(window.raw)))
+  {
+    window.header.page = page;
+    window.header.sequence = current.header.sequence + 1;
+
+    slaveWriteRegs(board, SLAVE_WINDOW_BASE, &window, sizeof(window));
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void slaveWriteRegs(struct Board *board, uint32_t position,
+    const void *buffer, size_t length)
+{
+  ifSetParam(board->system.slave, IF_POSITION, &position);
+  ifWrite(board->system.slave, buffer, length);
+}
+/*----------------------------------------------------------------------------*/
+static void startStorageOperation(struct Board *board,
+    enum StorageOperation operation)
+{
+  board->system.storage = operation;
+  raiseEvents(board, EVENT_STORAGE);
+}
+/*----------------------------------------------------------------------------*/
+static void switchOutputPath(struct Board *board)
+{
+  switch (board->config.outputPath)
+  {
+    case BOARD_AUDIO_OUTPUT_PATH_A:
+      board->config.outputChannels = BOARD_AUDIO_OUTPUT_CH_B;
+      board->config.outputPath = BOARD_AUDIO_OUTPUT_PATH_B;
+      break;
+
+    case BOARD_AUDIO_OUTPUT_PATH_B:
+      board->config.outputChannels = BOARD_AUDIO_OUTPUT_CH_A;
+      board->config.outputPath = BOARD_AUDIO_OUTPUT_PATH_A;
+      break;
+
+    default:
+      board->config.outputChannels = CHANNEL_NONE;
+      board->config.outputPath = AIC3X_NONE;
+      break;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool takeEvent(struct Board *board, uint16_t event)
+{
+  const IrqState state = irqSave();
+  const bool pending = (board->event.pending & event) != 0;
+
+  board->event.pending &= ~event;
+  irqRestore(state);
+
+  return pending;
+}
+/*----------------------------------------------------------------------------*/
+static void updateControlBus(struct Board *board, bool read)
+{
+  const uint8_t value = makeLedState(board);
+
+  ENTER_TASK(TASK_CONTROL_BUS);
+
+  if (read)
+  {
+    /* Switch poll and LED update share a single transfer */
+    TRACE(TRACE_LED_WRITE, value);
+    updateSwitchState(board, exchangeControlBus(board, value));
+  }
+  else if (value != board->indication.output)
+  {
+    writeLedState(board, value);
+  }
+
+  EXIT_TASK(TASK_CONTROL_BUS);
+}
+/*----------------------------------------------------------------------------*/
+static void updateSwitchState(struct Board *board, uint8_t state)
+{
+  if (state != board->system.sw)
+  {
+    if (!isSlaveMode(board))
+    {
+      const bool boost = (state & SW_OUTPUT_GAIN_BOOST) != 0;
+
+      pinWrite(board->codecPackage.mux, (state & SW_EXT_CLOCK) == 0);
+      pinWrite(board->ampPackage.gain0, boost);
+      pinWrite(board->ampPackage.gain1, boost);
+
+      codecSetAGCEnabled(board->codecPackage.codec,
+          (state & SW_INPUT_GAIN_AUTO) != 0);
+
+      board->system.sw = state;
+      raiseEvents(board, EVENT_CLOCK);
+    }
+    else
+    {
+      board->system.sw = state;
+      raiseCauses(board, SLAVE_CAUSE_SW);
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
 static void writeLedState(struct Board *board, uint8_t state)
 {
+  TRACE(TRACE_LED_WRITE, state);
+
   pinReset(board->controlPackage.csW);
   ifWrite(board->controlPackage.spi, &state, sizeof(state));
   pinSet(board->controlPackage.csW);
+
+  board->indication.output = state;
 }
 /*----------------------------------------------------------------------------*/
 static void onBusError(void *argument)
 {
   struct Board * const board = argument;
 
+  TRACE(TRACE_BUS_ERROR, board->system.retries);
+
 #ifdef ENABLE_DBG
   size_t count;
   char text[64];
@@ -248,10 +820,27 @@ static void onBusError(void *argument)
 
   ifSetParam(board->codecPackage.i2c, IF_I2C_BUS_RECOVERY, NULL);
 
+  board->system.quiet = 0;
+
+  if (++board->system.errors >= RATE_ERROR_LIMIT)
+  {
+    board->system.errors = 0;
+    setCodecRate(board, boardNextCodecRate(board->codecPackage.rate));
+  }
+
+  if (!board->system.retries)
+    board->system.fault = board->telemetry.uptime;
+
   if (board->system.retries < BUS_MAX_RETRIES)
   {
+    /* Next attempt is made on the control event after the delay */
+    const unsigned int shift = MIN(board->system.retries, 7);
+
+    board->schedule.recovery = (uint8_t)MIN(1 << shift, RECOVERY_MAX_DELAY);
     ++board->system.retries;
-    codecReset(board->codecPackage.codec);
+
+    /* Control timer may be programmed for the whole poll period */
+    shortenControlPeriod(board);
   }
 }
 /*----------------------------------------------------------------------------*/
@@ -259,91 +848,154 @@ static void onBusIdle(void *argument)
 {
   struct Board * const board = argument;
 
+  TRACE(TRACE_BUS_IDLE, board->system.retries);
+
+  /* Clock and filters are written when the driver finishes the codec reset */
+  board->system.reset = false;
+  raiseEvents(board, makeCodecEvents(board));
+
   if (board->system.retries)
   {
-    board->system.retries = 0;
+    const uint32_t duration = board->telemetry.uptime - board->system.fault;
 
-    micUpdateTask(board);
-    spkUpdateTask(board);
-    volumeUpdateTask(board);
+    ++board->telemetry.recoveries;
+    board->telemetry.recovery = (uint16_t)MIN(MAX(duration,
+        board->telemetry.recovery), UINT16_MAX);
+
+    board->schedule.recovery = 0;
+    board->system.retries = 0;
+    raiseEvents(board, EVENT_MIC | EVENT_SPK | EVENT_VOLUME);
   }
 }
 /*----------------------------------------------------------------------------*/
 static void onControlUpdateEvent(void *argument)
 {
   struct Board * const board = argument;
+  const uint8_t elapsed = board->schedule.period;
+  uint16_t events = 0;
 
-  if (board->codecPackage.codec != NULL)
+  TRACE(TRACE_CONTROL_UPDATE, elapsed);
+
+  board->telemetry.uptime += elapsed;
+
+  if (BOARD_ACTIVE_MODE && board->codecPackage.codec != NULL)
   {
-    /* Read and verify codec configuration */
-    codecCheck(board->codecPackage.codec);
+    if (elapse(&board->schedule.check, elapsed))
+    {
+      /* Lowered bus rate is raised step by step after a quiet interval */
+      if (board->system.quiet < RATE_QUIET_PERIODS)
+        ++board->system.quiet;
+      else
+        raiseCodecRate(board);
+
+      /* Verify the next window of codec registers */
+      board->schedule.check = CODEC_CHECK_PERIOD;
+      codecCacheVerify(board->codecPackage.cache);
+
+      /* One bus error is forgotten each check period */
+      if (board->system.errors)
+        --board->system.errors;
+
+      /* Failed clock and filter writes are repeated */
+      events |= makeCodecEvents(board);
+    }
+
+    if (board->schedule.recovery)
+    {
+      if (elapse(&board->schedule.recovery, elapsed))
+        recoverCodec(board);
+    }
   }
 
-  if (board->system.slave == NULL)
+  if (!isSlaveMode(board))
   {
-    if (++board->indication.blink == CONTROL_UPDATE_RATE)
-      board->indication.blink = 0;
+    board->indication.blink =
+        (board->indication.blink + elapsed) % CONTROL_UPDATE_RATE;
 
     if (board->indication.active)
     {
-      if (!--board->indication.active)
+      if (elapse(&board->indication.active, elapsed))
         board->config.mode = MODE_NONE;
     }
+
+    if (board->schedule.hold)
+    {
+      if (pinRead(board->buttonPackage.pins[1]))
+      {
+        /* Short press switches the output path on release */
+        board->schedule.hold = 0;
+        switchOutputPath(board);
+        events |= EVENT_SPK;
+      }
+      else if (elapse(&board->schedule.hold, elapsed))
+      {
+        board->config.mode = MODE_EQ;
+        board->indication.active = MODE_ACTIVE_TIMEOUT;
+      }
+    }
+
+    /* Blink phase or volume control mode may be changed */
+    events |= EVENT_LED;
   }
 
-  if (!board->event.read)
+  if (elapse(&board->schedule.poll, elapsed))
   {
-    if (wqAdd(WQ_DEFAULT, switchReadTask, board) == E_OK)
-      board->event.read = true;
+    board->schedule.poll = SWITCH_POLL_PERIOD;
+    events |= EVENT_SWITCH;
   }
 
   if (board->system.autosuspend)
   {
-    if (!board->system.timeout)
+    if (elapse(&board->system.timeout, elapsed))
     {
-      if (!board->event.suspend)
-      {
-        if (wqAdd(WQ_DEFAULT, autoSuspendTask, board) == E_OK)
-        {
-          board->system.timeout = AUTO_SUSPEND_TIMEOUT;
-          board->event.suspend = true;
-        }
-      }
+      board->system.timeout = AUTO_SUSPEND_TIMEOUT;
+      events |= EVENT_SUSPEND;
     }
-    else
-      --board->system.timeout;
   }
 
+#ifdef ENABLE_PROFILE
+  events |= EVENT_PROFILE;
+#endif
+
+  /* Dispatcher is also requeued here when the queue was full */
+  raiseEvents(board, events);
+
   if (board->system.watchdog != NULL)
     watchdogReload(board->system.watchdog);
+
+  /* Sleep until the nearest deadline */
+  setControlPeriod(board, nextControlPeriod(board));
 }
 /*----------------------------------------------------------------------------*/
 static void onConversionCompleted(void *argument)
 {
-  /* R1 = 20 kOhm, R2 = 10 kOhm, Vref = 3300 mV */
-  static const uint32_t r1Value = 20;
-  static const uint32_t r2Value = 10;
-  static const uint32_t refVoltage = 3300;
-
   struct Board * const board = argument;
+  struct SupplyMonitor * const supply = &board->system.supply;
   uint16_t sample;
-  uint32_t voltage;
   bool powered;
 
   ifRead(board->adcPackage.adc, &sample, sizeof(sample));
 
-  voltage = ((sample * refVoltage * (r1Value + r2Value)) / r2Value) >> 16;
-  powered = voltage >= VOLTAGE_THRESHOLD;
+  /* Thresholds are in ADC samples, decisions are made on filtered values */
+  if (!supplyMonitorUpdate(supply, sample))
+    return;
+
+  powered = supply->powered;
+
+  TRACE(TRACE_CONVERSION, powered);
+
+  /* Sample faster only while the voltage is close to the threshold */
+  const bool fast = supplyMonitorMargin(supply) < SUPPLY_NEAR_BAND;
+
+  if (fast != board->system.sampling)
+    setSamplingRate(board, fast);
 
   if (board->system.powered != powered)
   {
     board->system.powered = powered;
 
-    if (board->system.slave != NULL && !board->event.slave)
-    {
-      if (wqAdd(WQ_DEFAULT, slaveUpdateTask, board) == E_OK)
-        board->event.slave = true;
-    }
+    if (isSlaveMode(board))
+      raiseCauses(board, SLAVE_CAUSE_STATUS);
   }
 }
 /*----------------------------------------------------------------------------*/
@@ -351,6 +1003,8 @@ static void onMicPressed(void *argument)
 {
   struct Board * const board = argument;
 
+  TRACE(TRACE_BUTTON, 0);
+
   switch (board->config.inputPath)
   {
     case BOARD_AUDIO_INPUT_PATH_A:
@@ -369,56 +1023,35 @@ static void onMicPressed(void *argument)
       break;
   }
 
-  if (!board->event.codec)
-  {
-    if (wqAdd(WQ_DEFAULT, micUpdateTask, board) == E_OK)
-      board->event.codec = true;
-  }
+  raiseEvents(board, EVENT_MIC);
 }
 /*----------------------------------------------------------------------------*/
 static void onSlaveUpdateEvent(void *argument)
 {
   struct Board * const board = argument;
 
-  if (!board->event.slave)
-  {
-    if (wqAdd(WQ_DEFAULT, slaveUpdateTask, board) == E_OK)
-      board->event.slave = true;
-  }
+  TRACE(TRACE_SLAVE_UPDATE, 0);
+
+  raiseEvents(board, EVENT_SLAVE);
 }
 /*----------------------------------------------------------------------------*/
 static void onSpkPressed(void *argument)
 {
   struct Board * const board = argument;
-  switch (board->config.outputPath)
-  {
-    case BOARD_AUDIO_OUTPUT_PATH_A:
-      board->config.outputChannels = BOARD_AUDIO_OUTPUT_CH_B;
-      board->config.outputPath = BOARD_AUDIO_OUTPUT_PATH_B;
-      break;
-
-    case BOARD_AUDIO_OUTPUT_PATH_B:
-      board->config.outputChannels = BOARD_AUDIO_OUTPUT_CH_A;
-      board->config.outputPath = BOARD_AUDIO_OUTPUT_PATH_A;
-      break;
 
-    default:
-      board->config.outputChannels = CHANNEL_NONE;
-      board->config.outputPath = AIC3X_NONE;
-      break;
-  }
+  TRACE(TRACE_BUTTON, 1);
 
-  if (!board->event.codec)
-  {
-    if (wqAdd(WQ_DEFAULT, spkUpdateTask, board) == E_OK)
-      board->event.codec = true;
-  }
+  /* Release or long press is detected by the control event */
+  board->schedule.hold = LONG_PRESS_TIME;
+  shortenControlPeriod(board);
 }
 /*----------------------------------------------------------------------------*/
 static void onVolMPressed(void *argument)
 {
   struct Board * const board = argument;
 
+  TRACE(TRACE_BUTTON, 2);
+
   switch (board->config.mode)
   {
     case MODE_NONE:
@@ -426,35 +1059,40 @@ static void onVolMPressed(void *argument)
       break;
 
     case MODE_MIC:
-      if (!board->event.codec && board->config.inputLevel > MIN_LEVEL)
+      if (board->config.inputLevel > LEVEL_MIN)
       {
-        if (wqAdd(WQ_DEFAULT, volumeUpdateTask, board) == E_OK)
-        {
-          --board->config.inputLevel;
-          board->event.codec = true;
-        }
+        --board->config.inputLevel;
+        raiseEvents(board, EVENT_VOLUME);
       }
       break;
 
     case MODE_SPK:
-      if (!board->event.codec && board->config.outputLevel > MIN_LEVEL)
+      if (board->config.outputLevel > LEVEL_MIN)
       {
-        if (wqAdd(WQ_DEFAULT, volumeUpdateTask, board) == E_OK)
-        {
-          --board->config.outputLevel;
-          board->event.codec = true;
-        }
+        --board->config.outputLevel;
+        raiseEvents(board, EVENT_VOLUME);
+      }
+      break;
+
+    case MODE_EQ:
+      if (board->config.eq > CODEC_EQ_FLAT)
+      {
+        --board->config.eq;
+        raiseEvents(board, EVENT_EQ);
       }
       break;
   }
 
   board->indication.active = MODE_ACTIVE_TIMEOUT;
+  shortenControlPeriod(board);
 }
 /*----------------------------------------------------------------------------*/
 static void onVolPPressed(void *argument)
 {
   struct Board * const board = argument;
 
+  TRACE(TRACE_BUTTON, 3);
+
   switch (board->config.mode)
   {
     case MODE_NONE:
@@ -462,36 +1100,39 @@ static void onVolPPressed(void *argument)
       break;
 
     case MODE_MIC:
-      if (!board->event.codec && board->config.inputLevel < MAX_LEVEL)
+      if (board->config.inputLevel < LEVEL_MAX)
       {
-        if (wqAdd(WQ_DEFAULT, volumeUpdateTask, board) == E_OK)
-        {
-          ++board->config.inputLevel;
-          board->event.codec = true;
-        }
+        ++board->config.inputLevel;
+        raiseEvents(board, EVENT_VOLUME);
       }
       break;
 
     case MODE_SPK:
-      if (!board->event.codec && board->config.outputLevel < MAX_LEVEL)
+      if (board->config.outputLevel < LEVEL_MAX)
+      {
+        ++board->config.outputLevel;
+        raiseEvents(board, EVENT_VOLUME);
+      }
+      break;
+
+    case MODE_EQ:
+      if (board->config.eq < CODEC_EQ_COUNT - 1)
       {
-        if (wqAdd(WQ_DEFAULT, volumeUpdateTask, board) == E_OK)
-        {
-          ++board->config.outputLevel;
-          board->event.codec = true;
-        }
+        ++board->config.eq;
+        raiseEvents(board, EVENT_EQ);
       }
       break;
   }
 
   board->indication.active = MODE_ACTIVE_TIMEOUT;
+  shortenControlPeriod(board);
 }
 /*----------------------------------------------------------------------------*/
 static void autoSuspendTask(void *argument)
 {
   struct Board * const board = argument;
 
-  board->event.suspend = false;
+  ENTER_TASK(TASK_AUTO_SUSPEND);
 
   pinWrite(board->indication.red, BOARD_LED_INV);
   boardResetClock();
@@ -503,79 +1144,132 @@ static void autoSuspendTask(void *argument)
   interruptDisable(board->system.wakeup);
   boardSetupClock();
   pinWrite(board->indication.red, !BOARD_LED_INV);
+
+#ifdef ENABLE_DBG
+  /* Periodic event sources are stopped while the idle loop rate is measured */
+  timerDisable(board->controlPackage.timer);
+  timerDisable(board->adcPackage.timer);
+  startLoadCalibration(board);
+#endif
+
+  EXIT_TASK(TASK_AUTO_SUSPEND);
 }
 /*----------------------------------------------------------------------------*/
-static void ledUpdateTask(void *argument)
+static void clockUpdateTask(void *argument)
 {
   struct Board * const board = argument;
-  uint8_t value = 0;
+  const struct CodecClock * const clock = selectCodecClock(board);
 
-  board->event.show = false;
+  ENTER_TASK(TASK_CLOCK_UPDATE);
 
-  if (board->system.slave == NULL)
+  /*
+   * Only registers that differ from the previous entry are written.
+   * When the bus is busy the update is repeated on the idle event.
+   */
+  if (!board->system.reset && clock != board->codecPackage.clock)
   {
-    const bool enabled = board->indication.blink < CONTROL_UPDATE_RATE / 2;
+    /* Filter coefficients are uploaded again for the new sample rate */
+    if (boardSetCodecClock(&board->codecPackage, clock))
+      raiseEvents(board, EVENT_EQ);
+  }
 
-    switch (board->config.mode)
-    {
-      case MODE_MIC:
-        value |= levelToBar(board->config.inputLevel);
-        break;
+  EXIT_TASK(TASK_CLOCK_UPDATE);
+}
+/*----------------------------------------------------------------------------*/
+static void dispatchTask(void *argument)
+{
+  struct Board * const board = argument;
 
-      case MODE_SPK:
-        value |= levelToBar(board->config.outputLevel);
-        break;
+  ENTER_TASK(TASK_DISPATCH);
 
-      default:
-        break;
-    }
+#ifdef ENABLE_DBG
+  /* Calibration window is not idle when events are handled during it */
+  board->debug.busy = true;
+#endif
 
-    if (board->config.mode != MODE_MIC)
-    {
-      if (board->config.inputPath == BOARD_AUDIO_INPUT_PATH_A)
-        value |= 0x80;
-      else if (board->config.inputPath == BOARD_AUDIO_INPUT_PATH_B)
-        value |= 0x40;
-    }
-    else if (enabled)
-    {
-      value |= 0xC0;
-    }
+  /*
+   * Events raised by earlier handlers are processed in the same pass.
+   * Handlers of the mode not supported by the image are removed.
+   */
+  if (takeEvent(board, EVENT_SLAVE) && BOARD_SLAVE_MODE)
+    slaveUpdateTask(board);
+  if (takeEvent(board, EVENT_CLOCK) && BOARD_ACTIVE_MODE)
+    clockUpdateTask(board);
+  if (takeEvent(board, EVENT_EQ) && BOARD_ACTIVE_MODE)
+    eqUpdateTask(board);
+  if (takeEvent(board, EVENT_MIC) && BOARD_ACTIVE_MODE)
+    micUpdateTask(board);
+  if (takeEvent(board, EVENT_SPK) && BOARD_ACTIVE_MODE)
+    spkUpdateTask(board);
+  if (takeEvent(board, EVENT_VOLUME) && BOARD_ACTIVE_MODE)
+    volumeUpdateTask(board);
 
-    if (board->config.mode != MODE_SPK)
-    {
-      if (board->config.outputPath == BOARD_AUDIO_OUTPUT_PATH_A)
-        value |= 0x10;
-      else if (board->config.outputPath == BOARD_AUDIO_OUTPUT_PATH_B)
-        value |= 0x20;
-    }
-    else if (enabled)
-    {
-      value |= 0x30;
-    }
-  }
-  else
+  const bool read = takeEvent(board, EVENT_SWITCH);
+  const bool show = takeEvent(board, EVENT_LED);
+
+  if (read || show)
+    updateControlBus(board, read);
+
+#ifdef ENABLE_DBG
+  if (takeEvent(board, EVENT_DEBUG))
+    debugInfoTask(board);
+#endif
+
+#ifdef ENABLE_TRACE
+  if (takeEvent(board, EVENT_TRACE))
+    traceDumpTask(board);
+#endif
+
+#ifdef ENABLE_PROFILE
+  if (takeEvent(board, EVENT_PROFILE))
+    profileDumpTask(board);
+#endif
+
+  /* Flash operations are split into steps handled in separate passes */
+  if (takeEvent(board, EVENT_STORAGE) && BOARD_SLAVE_MODE)
+    storageUpdateTask(board);
+
+  /* Suspend is the last one because it returns only after wake-up */
+  if (takeEvent(board, EVENT_SUSPEND))
+    autoSuspendTask(board);
+
+  EXIT_TASK(TASK_DISPATCH);
+
+  /* Requeue the dispatcher when events were raised by interrupts */
+  board->event.queued = false;
+  raiseEvents(board, 0);
+}
+/*----------------------------------------------------------------------------*/
+static void eqUpdateTask(void *argument)
+{
+  struct Board * const board = argument;
+
+  ENTER_TASK(TASK_EQ_UPDATE);
+
+  /* Coefficients are written after the clock for the current sample rate */
+  if (!board->system.reset
+      && board->codecPackage.clock == selectCodecClock(board)
+      && board->codecPackage.eq != board->config.eq)
   {
-    value = board->indication.state;
+    boardSetCodecEq(&board->codecPackage, board->config.eq,
+        SAMPLE_RATE(board->system.sw));
   }
 
-  writeLedState(board, value);
+  EXIT_TASK(TASK_EQ_UPDATE);
 }
 /*----------------------------------------------------------------------------*/
 static void micUpdateTask(void *argument)
 {
   struct Board * const board = argument;
 
-  board->event.codec = false;
+  ENTER_TASK(TASK_MIC_UPDATE);
 
   codecSetInputPath(board->codecPackage.codec, board->config.inputPath,
       board->config.inputChannels);
 
-  if (!board->event.show)
-  {
-    if (wqAdd(WQ_DEFAULT, ledUpdateTask, board) == E_OK)
-      board->event.show = true;
-  }
+  raiseEvents(board, EVENT_LED);
+
+  EXIT_TASK(TASK_MIC_UPDATE);
 }
 /*----------------------------------------------------------------------------*/
 static void slaveUpdateTask(void *argument)
@@ -584,11 +1278,15 @@ static void slaveUpdateTask(void *argument)
       "Incorrect slave structure");
 
   struct Board * const board = argument;
+  struct SlaveRegOverlay * const shadow = &board->system.shadow;
+  struct SlaveRegOverlay current;
   struct SlaveRegOverlay overlay;
 
-  board->event.slave = false;
+  ENTER_TASK(TASK_SLAVE_UPDATE);
 
-  ifRead(board->system.slave, &overlay, sizeof(overlay));
+  ++board->telemetry.updates;
+  slaveReadRegs(board, SLAVE_REG_RESET, &current, sizeof(current));
+  overlay = current;
 
   /* Software reset control */
   if (overlay.reset & SLAVE_RESET_RESET)
@@ -597,42 +1295,123 @@ static void slaveUpdateTask(void *argument)
     /* Unreachable code */
   }
 
+  /* Clear unused bits */
+  overlay.sys &= SLAVE_SYS_MASK;
+  overlay.ctl &= SLAVE_CTL_MASK;
+  overlay.preset &= SLAVE_PRESET_MASK;
+
+  /* Report the result of the finished flash operation */
+  switch (board->system.stored)
+  {
+    case STORAGE_CONFIG:
+      overlay.sys &= ~SLAVE_SYS_SAVE_CONFIG;
+      if (board->system.failed)
+        overlay.sys |= SLAVE_SYS_SAVE_ERROR;
+      break;
+
+    case STORAGE_PRESET:
+      overlay.preset &= ~SLAVE_PRESET_STORE;
+      if (board->system.failed)
+        overlay.preset |= SLAVE_PRESET_ERROR;
+      break;
+
+    default:
+      break;
+  }
+  board->system.stored = STORAGE_NONE;
+
+  /* Preset recall replaces the whole scene with one register write */
+  if (overlay.preset & SLAVE_PRESET_RECALL)
+  {
+    struct Preset preset;
+
+    overlay.preset &= ~(SLAVE_PRESET_ERROR | SLAVE_PRESET_RECALL);
+
+    if (settingsWriterGetPreset(&board->system.writer,
+        SLAVE_PRESET_INDEX_VALUE(overlay.preset), &preset))
+    {
+      overlay.ctl = preset.ctl & SLAVE_CTL_MASK;
+      overlay.path = preset.path;
+      overlay.mic = preset.mic;
+      overlay.spk = preset.spk;
+    }
+    else
+      overlay.preset |= SLAVE_PRESET_ERROR;
+  }
+
   /* System control */
-  if (overlay.sys & SLAVE_SYS_EXT_CLOCK)
+  if (overlay.sys != shadow->sys)
   {
-    if ((overlay.sys & SLAVE_SYS_SUSPEND) && !board->event.suspend)
+    if (overlay.sys & SLAVE_SYS_EXT_CLOCK)
     {
-      if (wqAdd(WQ_DEFAULT, autoSuspendTask, board) == E_OK)
+      if (overlay.sys & SLAVE_SYS_SUSPEND)
       {
         overlay.sys &= ~SLAVE_SYS_SUSPEND;
-        board->event.suspend = true;
+        raiseEvents(board, EVENT_SUSPEND);
       }
-    }
 
-    board->system.autosuspend = (overlay.sys & SLAVE_SYS_SUSPEND_AUTO) != 0;
-    pinReset(board->codecPackage.mux);
-  }
-  else
-  {
-    board->system.autosuspend = false;
-    pinSet(board->codecPackage.mux);
+      board->system.autosuspend = (overlay.sys & SLAVE_SYS_SUSPEND_AUTO) != 0;
+      pinReset(board->codecPackage.mux);
+    }
+    else
+    {
+      board->system.autosuspend = false;
+      pinSet(board->codecPackage.mux);
+    }
   }
 
-  if (overlay.sys & SLAVE_SYS_SAVE_CONFIG)
+  /* Flash operations are started one at a time, requests stay pending */
+  if (board->system.storage == STORAGE_NONE)
   {
-    struct Settings settings;
+    if (overlay.sys & SLAVE_SYS_SAVE_CONFIG)
+    {
+      struct Settings settings;
 
-    memset(&settings, 0, sizeof(settings));
-    slaveStoreSettings(&settings, &overlay);
-    saveSettings(board->config.memory, FLASH_OFFSET, &settings);
+      memset(&settings, 0, sizeof(settings));
+      slaveStoreSettings(&settings, &overlay);
+      overlay.sys &= ~SLAVE_SYS_SAVE_ERROR;
 
-    overlay.sys &= ~SLAVE_SYS_SAVE_CONFIG;
+      /* Save flag is cleared when the write sequence is finished */
+      if (settingsWriterSaveSettings(&board->system.writer, &settings))
+        startStorageOperation(board, STORAGE_CONFIG);
+      else
+        overlay.sys &= ~SLAVE_SYS_SAVE_CONFIG;
+    }
+    else if (overlay.preset & SLAVE_PRESET_STORE)
+    {
+      const struct Preset preset = {
+          .ctl = overlay.ctl,
+          .path = overlay.path,
+          .mic = overlay.mic,
+          .spk = overlay.spk
+      };
+      const size_t index = SLAVE_PRESET_INDEX_VALUE(overlay.preset);
+
+      overlay.preset &= ~SLAVE_PRESET_ERROR;
+
+      if (index >= CONFIG_PRESET_COUNT)
+      {
+        overlay.preset &= ~SLAVE_PRESET_STORE;
+        overlay.preset |= SLAVE_PRESET_ERROR;
+      }
+      else if (settingsWriterSavePreset(&board->system.writer, index,
+          &preset))
+      {
+        startStorageOperation(board, STORAGE_PRESET);
+      }
+      else
+        overlay.preset &= ~SLAVE_PRESET_STORE;
+    }
   }
 
   /* Amplifier control */
-  pinWrite(board->ampPackage.power, (overlay.ctl & SLAVE_CTL_POWER) != 0);
-  pinWrite(board->ampPackage.gain0, (overlay.ctl & SLAVE_CTL_GAIN0) != 0);
-  pinWrite(board->ampPackage.gain1, (overlay.ctl & SLAVE_CTL_GAIN1) != 0);
+  if (overlay.ctl != shadow->ctl)
+  {
+    TRACE(TRACE_AMP_WRITE, overlay.ctl);
+    pinWrite(board->ampPackage.power, (overlay.ctl & SLAVE_CTL_POWER) != 0);
+    pinWrite(board->ampPackage.gain0, (overlay.ctl & SLAVE_CTL_GAIN0) != 0);
+    pinWrite(board->ampPackage.gain1, (overlay.ctl & SLAVE_CTL_GAIN1) != 0);
+  }
 
   /* External voltage status */
   overlay.status = board->system.powered ? SLAVE_STATUS_POWER_READY : 0;
@@ -642,32 +1421,45 @@ static void slaveUpdateTask(void *argument)
   {
     board->indication.state = overlay.led;
 
-    if (!board->event.show)
-    {
-      if (wqAdd(WQ_DEFAULT, ledUpdateTask, board) == E_OK)
-        board->event.show = true;
-    }
+    raiseEvents(board, EVENT_LED);
   }
 
   /* Switches */
   overlay.sw = board->system.sw;
 
-  /* Clear unused bits */
-  overlay.sys &= SLAVE_SYS_MASK;
-  overlay.ctl &= SLAVE_CTL_MASK;
+  /* Attention causes seen by the host and cleared are acknowledged */
+  overlay.cause = acknowledgeCauses(board, shadow->cause & ~current.cause);
 
-  /* Save the state to a backup memory */
-  boardSaveState(overlay.sys | (overlay.ctl << 8) | (overlay.led << 16));
+  /* Save the state to a backup memory when persistent registers changed */
+  if (overlay.sys != shadow->sys || overlay.ctl != shadow->ctl
+      || overlay.led != shadow->led)
+  {
+    const uint8_t sys = overlay.sys
+        & ~(SLAVE_SYS_SAVE_CONFIG | SLAVE_SYS_SAVE_ERROR);
+
+    boardSaveState(sys | (overlay.ctl << 8) | (overlay.led << 16));
+  }
+
+  /* Update the slave buffer only when the firmware changed some registers */
+  if (memcmp(&overlay, &current, sizeof(overlay)))
+    slaveWriteRegs(board, SLAVE_REG_RESET, &overlay, sizeof(overlay));
 
-  ifWrite(board->system.slave, &overlay, sizeof(overlay));
+  slaveUpdateWindow(board, &overlay);
+
+  /* Attention line is held until all causes are acknowledged */
+  setAttention(board, overlay.cause != 0);
+
+  *shadow = overlay;
   board->system.timeout = board->system.autosuspend ? AUTO_SUSPEND_TIMEOUT : 0;
+
+  EXIT_TASK(TASK_SLAVE_UPDATE);
 }
 /*----------------------------------------------------------------------------*/
 static void spkUpdateTask(void *argument)
 {
   struct Board * const board = argument;
 
-  board->event.codec = false;
+  ENTER_TASK(TASK_SPK_UPDATE);
 
   if (board->config.outputPath == BOARD_AUDIO_OUTPUT_PATH_B)
     pinSet(board->ampPackage.power);
@@ -677,11 +1469,9 @@ static void spkUpdateTask(void *argument)
   codecSetOutputPath(board->codecPackage.codec, board->config.outputPath,
       board->config.outputChannels);
 
-  if (!board->event.show)
-  {
-    if (wqAdd(WQ_DEFAULT, ledUpdateTask, board) == E_OK)
-      board->event.show = true;
-  }
+  raiseEvents(board, EVENT_LED);
+
+  EXIT_TASK(TASK_SPK_UPDATE);
 }
 /*----------------------------------------------------------------------------*/
 static void startupTask(void *argument)
@@ -689,9 +1479,24 @@ static void startupTask(void *argument)
   struct Board * const board = argument;
   struct Settings settings;
 
-  writeLedState(board, 0);
+#ifdef ENABLE_DBG
+  if (!board->debug.idle)
+  {
+    /* Idle loop rate is measured before event sources are enabled */
+    timerSetCallback(board->chronoPackage.load, onLoadTimerOverflow, board);
+    startLoadCalibration(board);
+
+    /* Startup task is queued again when the measurement is finished */
+    return;
+  }
+#endif
+
+  ENTER_TASK(TASK_STARTUP);
 
-  const uint8_t sw = readSwitchState(board);
+  /* Switch states are received during LED state transmission */
+  ifSetParam(board->controlPackage.spi, IF_SPI_BIDIRECTIONAL, NULL);
+
+  const uint8_t sw = exchangeControlBus(board, 0);
   const bool valid = loadSettings(board->config.memory, FLASH_OFFSET,
       &settings);
 
@@ -700,20 +1505,26 @@ static void startupTask(void *argument)
   else
     codecLoadDefaultSettings(board);
 
-  if (sw & SW_ACTIVE)
+  /* Mode is known at compile time when switch states are overridden */
+  const bool active = BOARD_ACTIVE_MODE
+      && (!BOARD_SLAVE_MODE || (sw & SW_ACTIVE));
+
+  /* Setup functions of the unused mode are not referenced by the image */
+  if (BOARD_ACTIVE_MODE && active)
   {
     const bool pll = (sw & SW_EXT_CLOCK) == 0;
 
-    board->codecPackage = boardSetupCodecPackage(WQ_DEFAULT, true, pll);
+    board->codecPackage = boardSetupCodecPackageActive(WQ_DEFAULT, pll);
+    board->system.reset = true;
     codecSetErrorCallback(board->codecPackage.codec, onBusError, board);
     codecSetIdleCallback(board->codecPackage.codec, onBusIdle, board);
 
-    switchReadTask(board);
+    updateSwitchState(board, sw);
     micUpdateTask(board);
     spkUpdateTask(board);
     volumeUpdateTask(board);
   }
-  else
+  else if (BOARD_SLAVE_MODE)
   {
     board->system.slave = boardMakeI2CSlave();
     board->system.sw = sw;
@@ -749,11 +1560,16 @@ static void startupTask(void *argument)
     ifWrite(board->system.slave, &overlay, sizeof(overlay));
     ifSetCallback(board->system.slave, onSlaveUpdateEvent, board);
 
-    board->codecPackage = boardSetupCodecPackage(NULL, false, false);
+    /* Invalidate the shadow copy to force a full update */
+    memset(&board->system.shadow, 0xFF, sizeof(board->system.shadow));
+
+    board->codecPackage = boardSetupCodecPackageSlave();
+    settingsWriterInit(&board->system.writer, board->config.memory,
+        FLASH_OFFSET);
     slaveUpdateTask(board);
   }
 
-  if (board->system.slave == NULL)
+  if (!isSlaveMode(board))
   {
     interruptSetCallback(board->buttonPackage.buttons[0], onMicPressed, board);
     interruptEnable(board->buttonPackage.buttons[0]);
@@ -765,76 +1581,77 @@ static void startupTask(void *argument)
     interruptEnable(board->buttonPackage.buttons[3]);
   }
 
-  timerSetOverflow(board->controlPackage.timer,
-      timerGetFrequency(board->controlPackage.timer) / CONTROL_UPDATE_RATE);
+  /* Control timer is reprogrammed to the nearest deadline on each event */
+  board->schedule.check = CODEC_CHECK_PERIOD;
+  board->schedule.poll = SWITCH_POLL_PERIOD;
+  setControlPeriod(board, nextControlPeriod(board));
   timerSetCallback(board->controlPackage.timer, onControlUpdateEvent, board);
   timerEnable(board->controlPackage.timer);
 
-  /* CONTROL_UPDATE_RATE * 2 Hz ADC trigger rate, start ADC sampling */
+  /* Start ADC sampling at the fast rate until the voltage is known */
   ifSetParam(board->adcPackage.adc, IF_ENABLE, NULL);
   ifSetCallback(board->adcPackage.adc, onConversionCompleted, board);
-  timerSetOverflow(board->adcPackage.timer,
-      timerGetFrequency(board->adcPackage.timer) / (CONTROL_UPDATE_RATE * 2));
+  setSamplingRate(board, true);
   timerEnable(board->adcPackage.timer);
 
-  /* Enable base timer factory timer */
-  timerEnable(board->chronoPackage.base);
+  if (!isSlaveMode(board))
+  {
+    /* Base timer of the timer factory is used only for button debouncing */
+    timerEnable(board->chronoPackage.base);
+  }
 
-#ifdef ENABLE_DBG
-  /* 24-bit SysTick timer is used for debug purposes */
-  timerSetCallback(board->chronoPackage.load, onLoadTimerOverflow, board);
-  timerSetOverflow(board->chronoPackage.load,
-      timerGetFrequency(board->chronoPackage.load));
-  timerEnable(board->chronoPackage.load);
+#ifdef ENABLE_TRACE
+  /* Timestamps are taken from the load timer */
+  traceInit(board->chronoPackage.load);
+  ifSetCallback(board->debug.serial, onSerialEvent, board);
 #endif
+
+#ifdef ENABLE_PROFILE
+  /* Intervals are measured with the load timer */
+  profileInit(board->chronoPackage.load);
+#endif
+
+  /* All objects are allocated by the setup functions above */
+  arenaSeal();
+
+  EXIT_TASK(TASK_STARTUP);
 }
 /*----------------------------------------------------------------------------*/
-static void switchReadTask(void *argument)
+static void storageUpdateTask(void *argument)
 {
   struct Board * const board = argument;
-  const uint8_t state = readSwitchState(board);
 
-  board->event.read = false;
+  ENTER_TASK(TASK_STORAGE_UPDATE);
 
-  if (state != board->system.sw)
-  {
-    if (board->system.slave == NULL)
-    {
-      const bool boost = (state & SW_OUTPUT_GAIN_BOOST) != 0;
+  const enum Result res = settingsWriterStep(&board->system.writer);
 
-      pinWrite(board->codecPackage.mux, (state & SW_EXT_CLOCK) == 0);
-      pinWrite(board->ampPackage.gain0, boost);
-      pinWrite(board->ampPackage.gain1, boost);
+  if (res == E_BUSY)
+  {
+    /* Let other tasks run between flash operations */
+    raiseEvents(board, EVENT_STORAGE);
+  }
+  else
+  {
+    board->system.failed = res != E_OK;
 
-      codecSetSampleRate(board->codecPackage.codec,
-          (state & SW_SAMPLE_RATE) ? 48000 : 44100);
-      codecSetAGCEnabled(board->codecPackage.codec,
-          (state & SW_INPUT_GAIN_AUTO) != 0);
+    if (res == E_OK)
+      ++board->telemetry.writes;
+    else
+      ++board->telemetry.failures;
+    board->system.stored = board->system.storage;
+    board->system.storage = STORAGE_NONE;
 
-      board->system.sw = state;
-    }
-    else if (!board->event.slave)
-    {
-      if (wqAdd(WQ_DEFAULT, slaveUpdateTask, board) == E_OK)
-      {
-        board->system.sw = state;
-        board->event.slave = true;
-      }
-    }
+    raiseCauses(board, SLAVE_CAUSE_STORAGE);
   }
 
-  if (board->system.slave == NULL && !board->event.show)
-  {
-    if (wqAdd(WQ_DEFAULT, ledUpdateTask, board) == E_OK)
-      board->event.show = true;
-  }
+  EXIT_TASK(TASK_STORAGE_UPDATE);
 }
 /*----------------------------------------------------------------------------*/
 static void volumeUpdateTask(void *argument)
 {
   struct Board * const board = argument;
 
-  board->event.codec = false;
+  ENTER_TASK(TASK_VOLUME_UPDATE);
 
   if (board->config.inputPath != AIC3X_NONE)
   {
@@ -851,34 +1668,77 @@ static void volumeUpdateTask(void *argument)
         CHANNEL_NONE : (CHANNEL_LEFT | CHANNEL_RIGHT));
   }
 
-  if (!board->event.show)
-  {
-    if (wqAdd(WQ_DEFAULT, ledUpdateTask, board) == E_OK)
-      board->event.show = true;
-  }
+  raiseEvents(board, EVENT_LED);
+
+  EXIT_TASK(TASK_VOLUME_UPDATE);
+}
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_DBG
+static void startLoadCalibration(struct Board *board)
+{
+  struct Timer * const timer = board->chronoPackage.load;
+  struct WqInfo info;
+
+  board->debug.calibration = CALIBRATION_ATTEMPTS;
+  board->debug.busy = false;
+
+  /* Window starts from zero, loops counted before it are dropped */
+  timerSetOverflow(timer, timerGetFrequency(timer) / CALIBRATION_RATE);
+  timerSetValue(timer, 0);
+  wqStatistics(WQ_DEFAULT, &info);
+  timerEnable(timer);
 }
+#endif
 /*----------------------------------------------------------------------------*/
 #ifdef ENABLE_DBG
 static void debugInfoTask(void *argument)
 {
   struct Board * const board = argument;
 
-  /* Heap used */
-  void * const stub = malloc(0);
-  const unsigned int used = (unsigned int)((uintptr_t)stub - (uintptr_t)board);
-  free(stub);
+  ENTER_TASK(TASK_DEBUG_INFO);
+
+  /* Load is relative to the idle loop rate measured without events */
+  const uint32_t loops = MIN(board->debug.loops, board->debug.idle);
 
   /* CPU used */
-  const unsigned int loops = board->debug.loops <= board->debug.idle ?
-      board->debug.idle - board->debug.loops : 0;
-  const unsigned int load = board->debug.idle > 100 ?
-      loops / (board->debug.idle / 100) : 100;
+  board->debug.load[board->debug.position] =
+      (uint8_t)(100 - loops * 100 / board->debug.idle);
+  board->debug.position = (board->debug.position + 1) % LOAD_WINDOW_SIZE;
+  if (board->debug.samples < LOAD_WINDOW_SIZE)
+    ++board->debug.samples;
 
-  size_t count;
-  char text[64];
+  unsigned int average = 0;
+  unsigned int maximum = 0;
+  unsigned int minimum = 100;
+
+  for (size_t i = 0; i < board->debug.samples; ++i)
+  {
+    const unsigned int load = board->debug.load[i];
+
+    average += load;
+    maximum = MAX(maximum, load);
+    minimum = MIN(minimum, load);
+  }
+  average /= board->debug.samples;
+
+  /* Peak memory usage */
+  struct MemoryUsage usage;
 
-  count = sprintf(text, "Heap %u ticks %u cpu %u%%\r\n", used, loops, load);
+  memoryMonitorGetUsage(&usage);
+
+  size_t count;
+  char text[128];
+
+  count = sprintf(text, "Heap %u stack %u free %u idle %lu cpu %u/%u/%u%% "
+      "wq %u/%u bus %lu %u/%u\r\n", (unsigned int)usage.heap,
+      (unsigned int)usage.stack, (unsigned int)usage.free,
+      (unsigned long)board->debug.idle, minimum, average, maximum,
+      board->telemetry.watermark, board->telemetry.rejected,
+      (unsigned long)board->codecPackage.rate,
+      board->telemetry.recoveries, board->telemetry.recovery);
   ifWrite(board->debug.serial, text, count);
+
+  EXIT_TASK(TASK_DEBUG_INFO);
 }
 #endif
 /*----------------------------------------------------------------------------*/
@@ -886,16 +1746,75 @@ static void debugInfoTask(void *argument)
 static void onLoadTimerOverflow(void *argument)
 {
   struct Board * const board = argument;
+  struct Timer * const timer = board->chronoPackage.load;
 
   struct WqInfo info;
   wqStatistics(WQ_DEFAULT, &info);
 
-  board->debug.loops = info.loops;
-  wqAdd(WQ_DEFAULT, debugInfoTask, board);
+  if (!board->debug.calibration)
+  {
+    board->debug.loops = info.loops;
+    raiseEvents(board, EVENT_DEBUG);
+    return;
+  }
+
+  const bool startup = !board->debug.idle;
+
+  if (!board->debug.busy)
+  {
+    board->debug.idle = MAX(info.loops, 1) * CALIBRATION_RATE;
+    board->debug.calibration = 0;
+  }
+  else if (--board->debug.calibration)
+  {
+    /* Measurement is repeated, previous idle loop rate is kept on failure */
+    board->debug.busy = false;
+    return;
+  }
+
+  timerSetOverflow(timer, timerGetFrequency(timer));
+
+  if (startup)
+  {
+    invokeStartupTask(board);
+  }
+  else
+  {
+    timerEnable(board->controlPackage.timer);
+    timerEnable(board->adcPackage.timer);
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_PROFILE
+static void profileDumpTask(void *argument)
+{
+  struct Board * const board = argument;
+  profileDump(board->debug.serial);
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_TRACE
+static void onSerialEvent(void *argument)
+{
+  struct Board * const board = argument;
+
+  /* Dump is continued when the transmit queue of the serial port drains */
+  if (traceReady())
+    raiseEvents(board, EVENT_TRACE);
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_TRACE
+static void traceDumpTask(void *argument)
+{
+  struct Board * const board = argument;
+  traceDump(board->debug.serial);
 }
 #endif
 /*----------------------------------------------------------------------------*/
 void invokeStartupTask(struct Board *board)
 {
-  wqAdd(WQ_DEFAULT, startupTask, board);
+  if (wqAdd(WQ_DEFAULT, startupTask, board) != E_OK)
+    ++board->telemetry.rejected;
 }
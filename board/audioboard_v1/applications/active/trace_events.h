@@ -0,0 +1,56 @@
+/*
+ * board/audioboard_v1/applications/active/trace_events.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef BOARD_AUDIOBOARD_V1_APPLICATIONS_ACTIVE_TRACE_EVENTS_H_
+#define BOARD_AUDIOBOARD_V1_APPLICATIONS_ACTIVE_TRACE_EVENTS_H_
+/*----------------------------------------------------------------------------*/
+#include <trace.h>
+/*----------------------------------------------------------------------------*/
+/* Names of enumerators are used by the trace decoder */
+enum
+{
+  /* Interrupt callbacks, argument is not used unless specified */
+  TRACE_BUS_ERROR       = 0x01,
+  TRACE_BUS_IDLE        = 0x02,
+  /* Argument is a button index */
+  TRACE_BUTTON          = 0x03,
+  TRACE_CONTROL_UPDATE  = 0x04,
+  /* Argument is a state of the external power supply */
+  TRACE_CONVERSION      = 0x05,
+  TRACE_SLAVE_UPDATE    = 0x06,
+  /* Argument is a number of failed attempts */
+  TRACE_BUS_RECOVERY    = 0x07,
+  /* Argument is a new codec bus rate in tens of kHz */
+  TRACE_BUS_RATE        = 0x08,
+
+  /* Output changes, argument is a new value */
+  TRACE_AMP_WRITE       = 0x10,
+  TRACE_LED_WRITE       = 0x11,
+
+  /* Work queue events, argument is a task identifier */
+  TRACE_TASK_QUEUED     = 0x20,
+  TRACE_TASK_REJECTED   = 0x21,
+  TRACE_TASK_ENTER      = 0x22,
+  TRACE_TASK_EXIT       = 0x23
+};
+
+enum
+{
+  TASK_AUTO_SUSPEND     = 0x01,
+  TASK_CONTROL_BUS      = 0x02,
+  TASK_DEBUG_INFO       = 0x03,
+  TASK_DISPATCH         = 0x04,
+  TASK_MIC_UPDATE       = 0x05,
+  TASK_SLAVE_UPDATE     = 0x06,
+  TASK_SPK_UPDATE       = 0x07,
+  TASK_STARTUP          = 0x08,
+  TASK_VOLUME_UPDATE    = 0x09,
+  TASK_STORAGE_UPDATE   = 0x0A,
+  TASK_CLOCK_UPDATE     = 0x0B,
+  TASK_EQ_UPDATE        = 0x0C
+};
+/*----------------------------------------------------------------------------*/
+#endif /* BOARD_AUDIOBOARD_V1_APPLICATIONS_ACTIVE_TRACE_EVENTS_H_ */
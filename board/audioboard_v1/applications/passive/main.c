@@ -22,13 +22,11 @@ int main(void)
   const struct Pin led = pinInit(BOARD_LED_PIN);
   pinOutput(led, false);
 
-  struct ChronoPackage chronoPackage = boardSetupChronoPackage();
   struct AmpPackage ampPackage = boardSetupAmpPackage();
-  struct ControlPackage controlPackage = boardSetupControlPackage(
-      chronoPackage.factory);
+  struct ControlPackage controlPackage = boardSetupControlPackage();
 
   /* Reset codec pins */
-  boardSetupCodecPackage(NULL, false, false);
+  boardSetupCodecPackageSlave();
 
   /* Reset LEDs */
   showStatus(controlPackage.spi, controlPackage.csW, 0);
@@ -5,10 +5,15 @@
  */
 
 #include "board_shared.h"
+#include "codec_cache.h"
+#include "codec_clock.h"
+#include "codec_eq.h"
 #include "slave.h"
 #include <dpm/audio/tlv320aic3x.h>
 #include <dpm/button.h>
 #include <halm/core/cortex/systick.h>
+#include <halm/delay.h>
+#include <halm/generic/i2c.h>
 #include <halm/generic/timer_factory.h>
 #include <halm/generic/work_queue.h>
 #include <halm/platform/lpc/adc.h>
@@ -23,9 +28,13 @@
 #include <halm/platform/lpc/spi.h>
 #include <halm/platform/lpc/wakeup_int.h>
 #include <halm/platform/lpc/wdt.h>
+#include <xcore/helpers.h>
 #include <assert.h>
 /*----------------------------------------------------------------------------*/
 #define BACKUP_MAGIC_WORD 0xB6A617A5UL
+#define CODEC_ADDRESS     0x18
+/* Codec sample rate register is rewritten after the codec reset */
+#define CODEC_PROBE_REG   2
 /*----------------------------------------------------------------------------*/
 #define PRI_TIMER_DBG 3
 
@@ -38,6 +47,60 @@
 #define PRI_ADC       0
 #define PRI_WAKEUP    0
 /*----------------------------------------------------------------------------*/
+static bool acquireCodecBus(struct CodecPackage *);
+static bool probeCodecRate(struct Interface *, uint32_t);
+static void releaseCodecBus(struct CodecPackage *);
+/*----------------------------------------------------------------------------*/
+/* Codec bus rates from Fast-mode Plus to Standard mode */
+static const uint32_t codecRates[] = {1000000, 400000, 100000};
+/*----------------------------------------------------------------------------*/
+static bool acquireCodecBus(struct CodecPackage *package)
+{
+  struct Interface * const interface = (struct Interface *)package->cache;
+
+  if (ifSetParam(interface, IF_ACQUIRE, NULL) != E_OK)
+    return false;
+
+  /* Registers are written synchronously between codec driver transfers */
+  ifSetParam(interface, IF_ADDRESS, &(uint32_t){CODEC_ADDRESS});
+  ifSetParam(interface, IF_BLOCKING, NULL);
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool probeCodecRate(struct Interface *i2c, uint32_t rate)
+{
+  /* Last pattern restores the default value of the register */
+  static const uint8_t patterns[] = {0x55, 0xAA, 0x00};
+
+  ifSetParam(i2c, IF_RATE, &rate);
+
+  for (size_t i = 0; i < ARRAY_SIZE(patterns); ++i)
+  {
+    const uint8_t request[] = {CODEC_PROBE_REG, patterns[i]};
+    uint8_t response;
+
+    if (ifWrite(i2c, request, sizeof(request)) != sizeof(request))
+      return false;
+
+    ifSetParam(i2c, IF_I2C_REPEATED_START, NULL);
+    if (ifWrite(i2c, request, 1) != 1)
+      return false;
+    if (ifRead(i2c, &response, 1) != 1 || response != patterns[i])
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void releaseCodecBus(struct CodecPackage *package)
+{
+  struct Interface * const interface = (struct Interface *)package->cache;
+
+  ifSetParam(interface, IF_ZEROCOPY, NULL);
+  ifSetParam(interface, IF_RELEASE, NULL);
+}
+/*----------------------------------------------------------------------------*/
 void boardResetClock(void)
 {
   static const struct GenericClockConfig mainClockConfigInt = {
@@ -90,6 +153,57 @@ void boardSetupDefaultWQ(void)
   assert(WQ_DEFAULT != NULL);
 }
 /*----------------------------------------------------------------------------*/
+uint32_t boardNextCodecRate(uint32_t rate)
+{
+  for (size_t i = 0; i < ARRAY_SIZE(codecRates) - 1; ++i)
+  {
+    if (codecRates[i] == rate)
+      return codecRates[i + 1];
+  }
+
+  return codecRates[ARRAY_SIZE(codecRates) - 1];
+}
+/*----------------------------------------------------------------------------*/
+uint32_t boardPrevCodecRate(uint32_t rate)
+{
+  for (size_t i = 1; i < ARRAY_SIZE(codecRates); ++i)
+  {
+    if (codecRates[i] == rate)
+      return codecRates[i - 1];
+  }
+
+  return codecRates[0];
+}
+/*----------------------------------------------------------------------------*/
+uint32_t boardProbeCodecRate(struct Interface *i2c)
+{
+  static const uint32_t address = CODEC_ADDRESS;
+
+  /* Codec registers are accessible shortly after the hardware reset */
+  const struct Pin reset = pinInit(BOARD_I2S_RST_PIN);
+
+  pinOutput(reset, false);
+  mdelay(1);
+  pinSet(reset);
+  mdelay(1);
+
+  ifSetParam(i2c, IF_ADDRESS, &address);
+
+  for (size_t i = 0; i < ARRAY_SIZE(codecRates); ++i)
+  {
+    if (probeCodecRate(i2c, codecRates[i]))
+      return codecRates[i];
+
+    ifSetParam(i2c, IF_I2C_BUS_RECOVERY, NULL);
+  }
+
+  /* Codec does not respond, keep the initial rate */
+  const uint32_t rate = codecRates[1];
+
+  ifSetParam(i2c, IF_RATE, &rate);
+  return rate;
+}
+/*----------------------------------------------------------------------------*/
 bool boardRecoverState(uint32_t *state)
 {
   const uint32_t * const backup = backupDomainAddress();
@@ -111,6 +225,38 @@ void boardSaveState(uint32_t state)
   backup[1] = state;
 }
 /*----------------------------------------------------------------------------*/
+bool boardSetCodecClock(struct CodecPackage *package,
+    const struct CodecClock *clock)
+{
+  if (!acquireCodecBus(package))
+    return false;
+
+  const bool ok = codecClockWrite((struct Interface *)package->cache,
+      package->clock, clock);
+
+  releaseCodecBus(package);
+
+  /* Filter coefficients depend on the sample rate */
+  package->clock = ok ? clock : NULL;
+  package->eq = CODEC_EQ_COUNT;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+bool boardSetCodecEq(struct CodecPackage *package, uint8_t preset,
+    uint32_t rate)
+{
+  if (!acquireCodecBus(package))
+    return false;
+
+  const bool ok = codecEqWrite((struct Interface *)package->cache,
+      codecEqFind(preset, rate));
+
+  releaseCodecBus(package);
+
+  package->eq = ok ? preset : CODEC_EQ_COUNT;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
 struct Interface *boardMakeAdc(void)
 {
   static const PinNumber adcPins[] = {
@@ -154,6 +300,19 @@ struct Timer *boardMakeCodecTimer(void)
   return timer;
 }
 /*----------------------------------------------------------------------------*/
+struct Timer *boardMakeControlTimer(void)
+{
+  static const struct GpTimerConfig timerConfig = {
+      .frequency = 1000,
+      .priority = PRI_TIMER_SYS,
+      .channel = GPTIMER_CT16B0
+  };
+
+  struct Timer * const timer = init(GpTimer, &timerConfig);
+  assert(timer != NULL);
+  return timer;
+}
+/*----------------------------------------------------------------------------*/
 struct Timer *boardMakeLoadTimer(void)
 {
   static const struct GpTimerConfig timerConfig = {
@@ -173,7 +332,7 @@ struct Entity *boardMakeCodec(struct WorkQueue *wq, struct Interface *i2c,
   const struct TLV320AIC3xConfig codecConfig = {
       .bus = i2c,
       .timer = timer,
-      .address = 0x18,
+      .address = CODEC_ADDRESS,
       .rate = 0,
       .samplerate = 44100,
       .prescaler = prescaler,
@@ -189,6 +348,20 @@ struct Entity *boardMakeCodec(struct WorkQueue *wq, struct Interface *i2c,
   return (struct Entity *)codec;
 }
 /*----------------------------------------------------------------------------*/
+struct CodecCache *boardMakeCodecCache(struct WorkQueue *wq,
+    struct Interface *i2c)
+{
+  const struct CodecCacheConfig cacheConfig = {
+      .bus = i2c,
+      .wq = wq,
+      .address = CODEC_ADDRESS
+  };
+
+  struct CodecCache * const cache = init(CodecCache, &cacheConfig);
+  assert(cache != NULL);
+  return cache;
+}
+/*----------------------------------------------------------------------------*/
 struct Interface *boardMakeI2CMaster(void)
 {
   static const struct I2CConfig i2cMasterConfig = {
@@ -207,7 +380,7 @@ struct Interface *boardMakeI2CMaster(void)
 struct Interface *boardMakeI2CSlave(void)
 {
   static const struct I2CSlaveConfig i2cSlaveConfig = {
-      .size = SLAVE_REG_COUNT,
+      .size = SLAVE_MAP_SIZE,
       .scl = PIN(0, 4),
       .sda = PIN(0, 5),
       .priority = PRI_I2C,
@@ -374,6 +547,8 @@ struct ButtonPackage boardSetupButtonPackage(struct TimerFactory *factory)
       "Incorrect event count");
   static_assert(ARRAY_SIZE(buttonIntConfigs) == ARRAY_SIZE(package.timers),
       "Incorrect timer count");
+  static_assert(ARRAY_SIZE(buttonIntConfigs) == ARRAY_SIZE(package.pins),
+      "Incorrect pin count");
 
   for (size_t i = 0; i < ARRAY_SIZE(buttonIntConfigs); ++i)
   {
@@ -392,6 +567,8 @@ struct ButtonPackage boardSetupButtonPackage(struct TimerFactory *factory)
     };
     package.buttons[i] = init(Button, &buttonConfig);
     assert(package.buttons[i] != NULL);
+
+    package.pins[i] = pinInit(buttonIntConfigs[i].pin);
   }
 
   return package;
@@ -414,7 +591,7 @@ struct ChronoPackage boardSetupChronoPackage(void)
   return package;
 }
 /*----------------------------------------------------------------------------*/
-struct CodecPackage boardSetupCodecPackage(struct WorkQueue *wq, bool active,
+struct CodecPackage boardSetupCodecPackageActive(struct WorkQueue *wq,
     bool pll)
 {
   struct CodecPackage package;
@@ -422,27 +599,42 @@ struct CodecPackage boardSetupCodecPackage(struct WorkQueue *wq, bool active,
   package.mux = pinInit(BOARD_I2S_MUX_PIN);
   pinOutput(package.mux, true);
 
-  if (active)
-  {
-    package.i2c = boardMakeI2CMaster();
-    package.timer = boardMakeCodecTimer();
-    package.codec = boardMakeCodec(wq, package.i2c, package.timer,
-        pll ? 0 : 256);
-  }
-  else
-  {
-    package.i2c = NULL;
-    package.timer = NULL;
-    package.codec = NULL;
+  package.i2c = boardMakeI2CMaster();
+  package.rate = boardProbeCodecRate(package.i2c);
+  package.limit = package.rate;
+  package.clock = NULL;
+  package.eq = CODEC_EQ_COUNT;
+  package.cache = boardMakeCodecCache(wq, package.i2c);
+  package.timer = boardMakeCodecTimer();
+  package.codec = boardMakeCodec(wq, (struct Interface *)package.cache,
+      package.timer, pll ? 0 : 256);
 
-    package.reset = pinInit(BOARD_I2S_RST_PIN);
-    pinOutput(package.reset, true);
-  }
+  return package;
+}
+/*----------------------------------------------------------------------------*/
+struct CodecPackage boardSetupCodecPackageSlave(void)
+{
+  struct CodecPackage package;
+
+  package.mux = pinInit(BOARD_I2S_MUX_PIN);
+  pinOutput(package.mux, true);
+
+  package.i2c = NULL;
+  package.rate = 0;
+  package.limit = 0;
+  package.clock = NULL;
+  package.eq = CODEC_EQ_COUNT;
+  package.cache = NULL;
+  package.timer = NULL;
+  package.codec = NULL;
+
+  package.reset = pinInit(BOARD_I2S_RST_PIN);
+  pinOutput(package.reset, true);
 
   return package;
 }
 /*----------------------------------------------------------------------------*/
-struct ControlPackage boardSetupControlPackage(struct TimerFactory *factory)
+struct ControlPackage boardSetupControlPackage(void)
 {
   struct ControlPackage package;
 
@@ -461,7 +653,7 @@ struct ControlPackage boardSetupControlPackage(struct TimerFactory *factory)
   pinOutput(package.csW, true);
 
   package.spi = boardMakeSpi();
-  package.timer = timerFactoryCreate(factory);
+  package.timer = boardMakeControlTimer();
 
   return package;
 }
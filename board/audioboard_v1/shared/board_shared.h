@@ -10,6 +10,8 @@
 #include <halm/pin.h>
 /*----------------------------------------------------------------------------*/
 #define BOARD_ADC_PIN                   PIN(1, 10)
+/* Optional open-drain host attention line, active low */
+#define BOARD_ATTENTION_PIN             PIN(0, 11)
 #define BOARD_BUTTON_MIC_PIN            PIN(0, 7)
 #define BOARD_BUTTON_SPK_PIN            PIN(1, 8)
 #define BOARD_BUTTON_VOL_M_PIN          PIN(1, 11)
@@ -36,6 +38,8 @@
 #define BOARD_AUDIO_OUTPUT_CH_B         (CHANNEL_LEFT | CHANNEL_RIGHT)
 #define BOARD_AUDIO_OUTPUT_PATH_B       AIC3X_LINE_OUT_DIFF
 /*----------------------------------------------------------------------------*/
+struct CodecCache;
+struct CodecClock;
 struct Interface;
 struct Interrupt;
 struct Timer;
@@ -61,6 +65,8 @@ struct ButtonPackage
   struct Interrupt *buttons[4];
   struct Interrupt *events[4];
   struct Timer *timers[4];
+  /* Pins for reading button states, low level means pressed */
+  struct Pin pins[4];
 };
 
 struct ChronoPackage
@@ -73,10 +79,19 @@ struct ChronoPackage
 struct CodecPackage
 {
   struct Entity *codec;
+  struct CodecCache *cache;
   struct Interface *i2c;
   struct Timer *timer;
   struct Pin mux;
   struct Pin reset;
+  /* Clock registers written to the codec, NULL when unknown */
+  const struct CodecClock *clock;
+  /* Rate of the codec bus */
+  uint32_t rate;
+  /* Highest rate passing the startup probe */
+  uint32_t limit;
+  /* Filter preset written to the codec, CODEC_EQ_COUNT when unknown */
+  uint8_t eq;
 };
 
 struct ControlPackage
@@ -96,12 +111,26 @@ void boardSetupDefaultWQ(void);
 bool boardRecoverState(uint32_t *);
 void boardSaveState(uint32_t);
 
+/* Highest codec bus rate passing a register read-back test */
+uint32_t boardProbeCodecRate(struct Interface *);
+/* Next lower codec bus rate or the lowest one */
+uint32_t boardNextCodecRate(uint32_t);
+/* Previous higher codec bus rate or the highest one */
+uint32_t boardPrevCodecRate(uint32_t);
+/* Rewrite changed clock registers, returns false when the bus is busy */
+bool boardSetCodecClock(struct CodecPackage *, const struct CodecClock *);
+/* Upload filter coefficients, returns false when the bus is busy */
+bool boardSetCodecEq(struct CodecPackage *, uint8_t, uint32_t);
+
 struct Interface *boardMakeAdc(void);
 struct Timer *boardMakeAdcTimer(void);
 struct Timer *boardMakeCodecTimer(void);
+struct Timer *boardMakeControlTimer(void);
 struct Timer *boardMakeLoadTimer(void);
 struct Entity *boardMakeCodec(struct WorkQueue *, struct Interface *,
     struct Timer *, uint16_t);
+struct CodecCache *boardMakeCodecCache(struct WorkQueue *,
+    struct Interface *);
 struct Interface *boardMakeI2CMaster(void);
 struct Interface *boardMakeI2CSlave(void);
 struct Interface *boardMakeMemory(void);
@@ -114,8 +143,11 @@ struct AdcPackage boardSetupAdcPackage(void);
 struct AmpPackage boardSetupAmpPackage(void);
 struct ButtonPackage boardSetupButtonPackage(struct TimerFactory *);
 struct ChronoPackage boardSetupChronoPackage(void);
-struct CodecPackage boardSetupCodecPackage(struct WorkQueue *, bool, bool);
-struct ControlPackage boardSetupControlPackage(struct TimerFactory *);
+/* Codec is configured by the MCU over the I2C bus */
+struct CodecPackage boardSetupCodecPackageActive(struct WorkQueue *, bool);
+/* Codec is held in reset and configured by the host */
+struct CodecPackage boardSetupCodecPackageSlave(void);
+struct ControlPackage boardSetupControlPackage(void);
 
 END_DECLS
 /*----------------------------------------------------------------------------*/
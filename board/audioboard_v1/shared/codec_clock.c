@@ -0,0 +1,140 @@
+/*
+ * codec_clock.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "codec_clock.h"
+#include <xcore/helpers.h>
+#include <xcore/interface.h>
+#include <assert.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+/* Clock output of the MCU connected to the PLL input */
+#define PLL_INPUT               12000000
+
+/* P = 1 and R = 1, K = J.D gives 2048 * Fsref at the PLL output */
+#define PLL_K(fsref)            ((uint64_t)(fsref) * 2048 * 10000 / PLL_INPUT)
+#define PLL_J(fsref)            (PLL_K(fsref) / 10000)
+#define PLL_D(fsref)            (PLL_K(fsref) % 10000)
+
+#define PLL_EXACT(fsref) \
+    ((uint64_t)(fsref) * 2048 * 10000 % PLL_INPUT == 0)
+#define PLL_VALID(fsref) \
+    (PLL_EXACT(fsref) && PLL_J(fsref) >= 4 && PLL_J(fsref) <= 11)
+
+/* Register 2: ADC and DAC rates, divider is doubled to fit Fsref / 1.5 */
+#define REG_RATE(divider)       ((((divider) - 2) << 4) | ((divider) - 2))
+/* Register 3: PLL enabled with Q = 2 and P = 1 or the reset value */
+#define REG_PLL_A(pll)          ((pll) ? 0x91 : 0x10)
+/* Registers 4 to 6: PLL J and D values or the reset values */
+#define REG_PLL_B(pll, fsref)   ((pll) ? PLL_J(fsref) << 2 : 0x04)
+#define REG_PLL_C(pll, fsref)   ((pll) ? PLL_D(fsref) >> 6 : 0x00)
+#define REG_PLL_D(pll, fsref)   ((pll) ? (PLL_D(fsref) & 0x3F) << 2 : 0x00)
+/* Register 7: reference rate, dual rate mode and straight DAC data paths */
+#define REG_DATAPATH(fsref, dual) \
+    (((fsref) == 44100 ? 0x80 : 0x00) | ((dual) ? 0x60 : 0x00) | 0x0A)
+/* Register 101: CODEC_CLKIN is taken from PLLDIV_OUT or CLKDIV_OUT */
+#define REG_CLKIN(pll)          ((pll) ? 0x00 : 0x01)
+
+#define CLOCK_REGS(pll, fsref, divider, dual) \
+    {{ \
+        REG_RATE(divider), \
+        REG_PLL_A(pll), \
+        REG_PLL_B(pll, fsref), \
+        REG_PLL_C(pll, fsref), \
+        REG_PLL_D(pll, fsref), \
+        REG_DATAPATH(fsref, dual), \
+        REG_CLKIN(pll) \
+    }}
+
+/* Sample rate is Fsref * 2 / divider or Fsref * 2 in dual rate mode */
+#define CLOCK_ENTRY(fsref, divider, dual) \
+    { \
+        (dual) ? (fsref) * 2 : (fsref) * 2 / (divider), \
+        { \
+            CLOCK_REGS(false, fsref, divider, dual), \
+            CLOCK_REGS(true, fsref, divider, dual) \
+        } \
+    }
+
+struct ClockEntry
+{
+  uint32_t rate;
+  /* Entries for the external MCLK signal and for the PLL */
+  struct CodecClock clocks[2];
+};
+
+static_assert(PLL_VALID(44100), "Incorrect PLL settings for 44.1 kHz");
+static_assert(PLL_VALID(48000), "Incorrect PLL settings for 48 kHz");
+/*----------------------------------------------------------------------------*/
+static bool isRegChanged(const struct CodecClock *, const struct CodecClock *,
+    size_t);
+/*----------------------------------------------------------------------------*/
+static const uint8_t clockRegs[CODEC_CLOCK_REGS] = {2, 3, 4, 5, 6, 7, 101};
+
+static const struct ClockEntry clockTable[] = {
+    CLOCK_ENTRY(48000, 12, false),
+    CLOCK_ENTRY(48000, 6, false),
+    CLOCK_ENTRY(44100, 4, false),
+    CLOCK_ENTRY(48000, 3, false),
+    CLOCK_ENTRY(44100, 2, false),
+    CLOCK_ENTRY(48000, 2, false),
+    CLOCK_ENTRY(48000, 2, true)
+};
+/*----------------------------------------------------------------------------*/
+static bool isRegChanged(const struct CodecClock *current,
+    const struct CodecClock *next, size_t index)
+{
+  return current == NULL || current->regs[index] != next->regs[index];
+}
+/*----------------------------------------------------------------------------*/
+const struct CodecClock *codecClockFind(uint32_t rate, bool pll)
+{
+  for (size_t i = 0; i < ARRAY_SIZE(clockTable); ++i)
+  {
+    if (clockTable[i].rate == rate)
+      return &clockTable[i].clocks[pll ? 1 : 0];
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+bool codecClockWrite(struct Interface *interface,
+    const struct CodecClock *current, const struct CodecClock *next)
+{
+  static const uint8_t page[] = {0, 0};
+  uint8_t buffer[CODEC_CLOCK_REGS + 1];
+  size_t index = 0;
+
+  /* All clock registers are located on page 0 */
+  if (ifWrite(interface, page, sizeof(page)) != sizeof(page))
+    return false;
+
+  while (index < CODEC_CLOCK_REGS)
+  {
+    if (!isRegChanged(current, next, index))
+    {
+      ++index;
+      continue;
+    }
+
+    size_t length = 0;
+
+    /* Adjacent changed registers are written in one transfer */
+    buffer[length++] = clockRegs[index];
+
+    do
+    {
+      buffer[length++] = next->regs[index++];
+    }
+    while (index < CODEC_CLOCK_REGS
+        && clockRegs[index] == clockRegs[index - 1] + 1
+        && isRegChanged(current, next, index));
+
+    if (ifWrite(interface, buffer, length) != length)
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,38 @@
+/*
+ * board/audioboard_v1/shared/codec_clock.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef BOARD_AUDIOBOARD_V1_SHARED_CODEC_CLOCK_H_
+#define BOARD_AUDIOBOARD_V1_SHARED_CODEC_CLOCK_H_
+/*----------------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Page 0 registers 2 to 7 and 101 of the codec */
+#define CODEC_CLOCK_REGS 7
+
+struct Interface;
+
+/*
+ * Values of the clock registers for one sample rate and MCLK source.
+ * The PLL is driven by the 12 MHz clock output of the MCU, the external
+ * MCLK signal should be 256 times the reference rate of 44.1 or 48 kHz.
+ */
+struct CodecClock
+{
+  uint8_t regs[CODEC_CLOCK_REGS];
+};
+/*----------------------------------------------------------------------------*/
+/* Returns NULL when the sample rate is not supported */
+const struct CodecClock *codecClockFind(uint32_t, bool);
+
+/*
+ * Write registers that differ between the current and the next entries,
+ * all registers are written when the current entry is unknown.
+ */
+bool codecClockWrite(struct Interface *, const struct CodecClock *,
+    const struct CodecClock *);
+/*----------------------------------------------------------------------------*/
+#endif /* BOARD_AUDIOBOARD_V1_SHARED_CODEC_CLOCK_H_ */
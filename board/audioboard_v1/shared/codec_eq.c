@@ -0,0 +1,83 @@
+/*
+ * codec_eq.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "codec_eq.h"
+#include "codec_eq_table.h"
+#include <xcore/helpers.h>
+#include <xcore/interface.h>
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define REG_PAGE_SELECT   0
+/* Page 0: digital filter control */
+#define REG_FILTER        12
+/* Page 1: first coefficients of the left and right channels */
+#define REG_LEFT_N0       1
+#define REG_RIGHT_N0      27
+
+/* Effects filters of the left and right DAC */
+#define FILTER_EFFECTS    0x0A
+
+static_assert(ARRAY_SIZE(codecEqTable) == CODEC_EQ_COUNT - 1,
+    "Generated presets differ from the preset list");
+static_assert(ARRAY_SIZE(codecEqTable[0]) == ARRAY_SIZE(codecEqRates),
+    "Generated table is incomplete");
+/*----------------------------------------------------------------------------*/
+static bool writeReg(struct Interface *, uint8_t, uint8_t);
+/*----------------------------------------------------------------------------*/
+static bool writeReg(struct Interface *interface, uint8_t reg, uint8_t value)
+{
+  const uint8_t buffer[] = {reg, value};
+  return ifWrite(interface, buffer, sizeof(buffer)) == sizeof(buffer);
+}
+/*----------------------------------------------------------------------------*/
+const struct CodecEq *codecEqFind(enum CodecEqPreset preset, uint32_t rate)
+{
+  if (preset == CODEC_EQ_FLAT || preset >= CODEC_EQ_COUNT)
+    return NULL;
+
+  for (size_t i = 0; i < ARRAY_SIZE(codecEqRates); ++i)
+  {
+    if (codecEqRates[i] == rate)
+      return &codecEqTable[preset - 1][i];
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+bool codecEqWrite(struct Interface *interface, const struct CodecEq *eq)
+{
+  static const uint8_t channels[] = {REG_LEFT_N0, REG_RIGHT_N0};
+  uint8_t buffer[CODEC_EQ_LENGTH + 1];
+
+  /* Filter is bypassed while the coefficients are changed */
+  if (!writeReg(interface, REG_PAGE_SELECT, 0))
+    return false;
+  if (!writeReg(interface, REG_FILTER, 0))
+    return false;
+  if (eq == NULL)
+    return true;
+
+  if (!writeReg(interface, REG_PAGE_SELECT, 1))
+    return false;
+
+  /* Coefficients of each channel are sent in one auto-increment burst */
+  memcpy(buffer + 1, eq->coefficients, CODEC_EQ_LENGTH);
+
+  for (size_t i = 0; i < ARRAY_SIZE(channels); ++i)
+  {
+    buffer[0] = channels[i];
+
+    if (ifWrite(interface, buffer, sizeof(buffer)) != sizeof(buffer))
+      return false;
+  }
+
+  if (!writeReg(interface, REG_PAGE_SELECT, 0))
+    return false;
+
+  return writeReg(interface, REG_FILTER, FILTER_EFFECTS);
+}
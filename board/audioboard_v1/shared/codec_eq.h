@@ -0,0 +1,43 @@
+/*
+ * board/audioboard_v1/shared/codec_eq.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef BOARD_AUDIOBOARD_V1_SHARED_CODEC_EQ_H_
+#define BOARD_AUDIOBOARD_V1_SHARED_CODEC_EQ_H_
+/*----------------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Two biquad sections with 16-bit coefficients in page 1 of the codec */
+#define CODEC_EQ_LENGTH 20
+
+/* Coefficients of presets except the flat one are generated at build time */
+enum CodecEqPreset
+{
+  CODEC_EQ_FLAT,
+  CODEC_EQ_BASS,
+  CODEC_EQ_VOICE,
+  CODEC_EQ_TREBLE,
+  CODEC_EQ_COUNT
+};
+
+struct Interface;
+
+/* Coefficients of the DAC digital effects filter for one sample rate */
+struct CodecEq
+{
+  uint8_t coefficients[CODEC_EQ_LENGTH];
+};
+/*----------------------------------------------------------------------------*/
+/* Returns NULL for the flat preset and for unsupported sample rates */
+const struct CodecEq *codecEqFind(enum CodecEqPreset, uint32_t);
+
+/*
+ * Upload coefficients for both channels and enable the effects filter,
+ * the filter is disabled when coefficients are not provided.
+ */
+bool codecEqWrite(struct Interface *, const struct CodecEq *);
+/*----------------------------------------------------------------------------*/
+#endif /* BOARD_AUDIOBOARD_V1_SHARED_CODEC_EQ_H_ */
@@ -25,7 +25,9 @@ enum
   SW_OUTPUT_GAIN_BOOST  = 0x20
 };
 
-#define SW_MASK           MASK(6)
-#define VOLTAGE_THRESHOLD 4900
+#define SW_MASK             MASK(6)
+#define VOLTAGE_THRESHOLD   4900
+/* Width of the band around the threshold where the state is kept */
+#define VOLTAGE_HYSTERESIS  100
 /*----------------------------------------------------------------------------*/
 #endif /* BOARD_AUDIOBOARD_V1_SHARED_CONTROLS_H_ */
@@ -0,0 +1,58 @@
+/*
+ * board/audioboard_v1/shared/conversions.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef BOARD_AUDIOBOARD_V1_SHARED_CONVERSIONS_H_
+#define BOARD_AUDIOBOARD_V1_SHARED_CONVERSIONS_H_
+/*----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+#define LEVEL_MIN               0
+#define LEVEL_MAX               7
+
+/* Codec gain of the level and segments of the 4-segment level bar */
+#define LEVEL_TO_GAIN(level)    ((level) * 255 / LEVEL_MAX)
+#define LEVEL_TO_BAR(level)     ((0xF0 >> (((level) + 1) / 2)) & 0x0F)
+
+#define LEVEL_TABLE(conversion) \
+    { \
+        conversion(0), conversion(1), conversion(2), conversion(3), \
+        conversion(4), conversion(5), conversion(6), conversion(7) \
+    }
+
+/* Equals gain * LEVEL_MAX / 255 for all 8-bit gains */
+#define GAIN_TO_LEVEL_FACTOR    225
+#define GAIN_TO_LEVEL_SHIFT     13
+
+/* Supply voltage divider: R1 = 20 kOhm, R2 = 10 kOhm, Vref = 3300 mV */
+#define VOLTAGE_SCALE           (3300 * (20 + 10) / 10)
+
+/* Conversions between millivolts and left-aligned 16-bit ADC samples */
+#define SAMPLE_TO_VOLTAGE(sample) \
+    (((uint32_t)(sample) * VOLTAGE_SCALE) >> 16)
+#define VOLTAGE_TO_SAMPLE(voltage) \
+    ((((uint32_t)(voltage) << 16) + VOLTAGE_SCALE - 1) / VOLTAGE_SCALE)
+
+static_assert(LEVEL_MAX == 7, "Level table should be updated");
+/*----------------------------------------------------------------------------*/
+static inline uint8_t gainToLevel(uint8_t gain)
+{
+  return (uint8_t)((gain * GAIN_TO_LEVEL_FACTOR) >> GAIN_TO_LEVEL_SHIFT);
+}
+/*----------------------------------------------------------------------------*/
+static inline uint8_t levelToBar(uint8_t level)
+{
+  static const uint8_t table[] = LEVEL_TABLE(LEVEL_TO_BAR);
+  return table[level];
+}
+/*----------------------------------------------------------------------------*/
+static inline uint8_t levelToGain(uint8_t level)
+{
+  static const uint8_t table[] = LEVEL_TABLE(LEVEL_TO_GAIN);
+  return table[level];
+}
+/*----------------------------------------------------------------------------*/
+#endif /* BOARD_AUDIOBOARD_V1_SHARED_CONVERSIONS_H_ */
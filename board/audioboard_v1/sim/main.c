@@ -0,0 +1,590 @@
+/*
+ * board/audioboard_v1/sim/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "board.h"
+#include "controls.h"
+#include "model.h"
+#include "tasks.h"
+#include "version.h"
+#include <slave.h>
+#include <xcore/helpers.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define MS(value)     ((uint64_t)(value) * 1000)
+#define SUPPLY_OK     5000
+
+/* Warm-up interval excluded from the statistics */
+#define BOOT_TIME     MS(1000)
+/* Duration of the measured part of each scenario */
+#define RUN_TIME      MS(10000)
+/* Settings records saved by the host, one flash sector holds 16 records */
+#define SAVE_COUNT    48
+
+/* Expected range of a reported value */
+struct Limit
+{
+  const char *name;
+  unsigned long min;
+  unsigned long max;
+};
+
+struct Scenario
+{
+  const char *name;
+  const char *description;
+  uint8_t sw;
+  void (*run)(struct Board *, struct BoardModel *);
+
+  /* Limits of the reported values, terminated by an empty entry */
+  const struct Limit *limits;
+};
+/*----------------------------------------------------------------------------*/
+static bool checkLimits(void);
+static void printStats(const struct BoardModel *, uint64_t);
+static void report(const char *, unsigned long);
+static void runActiveButtons(struct Board *, struct BoardModel *);
+static void runActiveBusError(struct Board *, struct BoardModel *);
+static void runIdle(struct Board *, struct BoardModel *);
+static void runSlaveAttention(struct Board *, struct BoardModel *);
+static void runSlaveLed(struct Board *, struct BoardModel *);
+static void runSlavePoll(struct Board *, struct BoardModel *);
+static void runSlaveSave(struct Board *, struct BoardModel *);
+static void runSlaveWindow(struct Board *, struct BoardModel *);
+static void runSupplyNoise(struct Board *, struct BoardModel *);
+/*----------------------------------------------------------------------------*/
+static const struct Scenario scenarios[] = {
+    {
+        "slave-idle",
+        "slave mode without host activity",
+        0,
+        runIdle,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 25},
+            {"rejected", 0, 0},
+            {"i2c_transfers", 0, 0},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "slave-poll",
+        "host reads the status register at 50 Hz",
+        0,
+        runSlavePoll,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 75},
+            {"rejected", 0, 0},
+            {"i2c_transfers", 0, 0},
+            /* Control bus is not accessed on each poll */
+            {"spi_transfers_per_100_polls", 0, 25},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "slave-attention",
+        "host reads the status only when the attention line is asserted",
+        0,
+        runSlaveAttention,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 50},
+            {"rejected", 0, 0},
+            /* One request for each of 10 supply changes */
+            {"attention_requests", 5, 30},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "slave-led",
+        "latency from an LED register write to the LED outputs",
+        0,
+        runSlaveLed,
+        (const struct Limit []){
+            {"rejected", 0, 0},
+            {"led_missed", 0, 0},
+            {"led_latency_max_us", 0, 5000},
+            {NULL, 0, 0}
+        }
+    }, {
+        "slave-window",
+        "host selects a window page and waits for the window update",
+        0,
+        runSlaveWindow,
+        (const struct Limit []){
+            {"rejected", 0, 0},
+            {"window_mismatched", 0, 0},
+            {"window_latency_max_us", 0, SLAVE_WINDOW_TURNAROUND},
+            {NULL, 0, 0}
+        }
+    }, {
+        "slave-save",
+        "host saves settings with different levels",
+        0,
+        runSlaveSave,
+        (const struct Limit []){
+            {"rejected", 0, 0},
+            {"save_failures", 0, 0},
+            /* Records are appended until the sector is full */
+            {"flash_erases", 0, SAVE_COUNT / 16 + 1},
+            {"flash_programs", SAVE_COUNT, SAVE_COUNT},
+            {NULL, 0, 0}
+        }
+    }, {
+        "active-idle",
+        "active mode without user activity",
+        SW_ACTIVE,
+        runIdle,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 40},
+            {"rejected", 0, 0},
+            /* Codec registers are verified once per second */
+            {"i2c_transfers", 0, 100},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "active-buttons",
+        "volume and mute buttons pressed in active mode",
+        SW_ACTIVE,
+        runActiveButtons,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 400},
+            {"rejected", 0, 0},
+            {"i2c_transfers_per_press", 0, 25},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "active-bus-error",
+        "codec stops responding for 1.5 seconds in active mode",
+        SW_ACTIVE,
+        runActiveBusError,
+        (const struct Limit []){
+            {"rejected", 0, 0},
+            {"bus_missed", 0, 0},
+            {"bus_rate_restored", 1, 1},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }, {
+        "supply-noise",
+        "supply voltage fluctuates around the threshold",
+        0,
+        runSupplyNoise,
+        (const struct Limit []){
+            {"wakeups_per_s", 0, 200},
+            {"rejected", 0, 0},
+            {"flash_erases", 0, 0},
+            {NULL, 0, 0}
+        }
+    }
+};
+
+static const struct Scenario *scenario = NULL;
+static unsigned int matches = 0;
+static unsigned int violations = 0;
+/*----------------------------------------------------------------------------*/
+static bool checkLimits(void)
+{
+  unsigned int count = 0;
+
+  while (scenario->limits[count].name != NULL)
+    ++count;
+
+  /* Each limit should be matched by exactly one reported value */
+  if (matches != count)
+  {
+    fprintf(stderr, "sim: %u of %u limits were checked\n", matches, count);
+    return false;
+  }
+
+  return violations == 0;
+}
+/*----------------------------------------------------------------------------*/
+static void printStats(const struct BoardModel *model, uint64_t elapsed)
+{
+  const struct SimStats * const stats = simStats();
+
+  printf("scenario=%s\n", scenario->name);
+  report("wakeups", stats->wakeups);
+  report("wakeups_per_s",
+      (unsigned long)((uint64_t)stats->wakeups * MS(1000) / elapsed));
+  report("tasks", stats->tasks);
+  report("rejected", stats->rejected);
+  report("watermark", stats->watermark);
+  report("i2c_transfers", stats->i2cTransfers);
+  report("i2c_bytes", stats->i2cBytes);
+  report("i2c_time_us", stats->i2cTime);
+  report("spi_transfers", stats->spiTransfers);
+  report("spi_bytes", stats->spiBytes);
+  report("flash_erases", stats->flashErases);
+  report("flash_programs", stats->flashPrograms);
+  report("busy_us", stats->busyTime);
+  report("suspends", stats->suspends);
+  printf("led=0x%02X\n", model->led);
+}
+/*----------------------------------------------------------------------------*/
+static void report(const char *name, unsigned long value)
+{
+  printf("%s=%lu\n", name, value);
+
+  for (const struct Limit *limit = scenario->limits; limit->name != NULL;
+      ++limit)
+  {
+    if (strcmp(limit->name, name))
+      continue;
+
+    ++matches;
+
+    if (value < limit->min || value > limit->max)
+    {
+      fprintf(stderr, "sim: %s=%lu is out of range %lu..%lu\n",
+          name, value, limit->min, limit->max);
+      ++violations;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runActiveButtons(struct Board *, struct BoardModel *)
+{
+  static const PinNumber sequence[] = {
+      BOARD_BUTTON_VOL_P_PIN,
+      BOARD_BUTTON_VOL_P_PIN,
+      BOARD_BUTTON_VOL_M_PIN,
+      BOARD_BUTTON_MIC_PIN,
+      BOARD_BUTTON_MIC_PIN,
+      BOARD_BUTTON_SPK_PIN,
+      BOARD_BUTTON_SPK_PIN
+  };
+  const uint64_t end = simTime() + RUN_TIME;
+  unsigned long presses = 0;
+
+  while (simTime() < end)
+  {
+    for (size_t i = 0; i < ARRAY_SIZE(sequence); ++i)
+      modelPressButton(sequence[i]);
+
+    presses += ARRAY_SIZE(sequence);
+    simAdvance(MS(300));
+  }
+
+  report("button_presses", presses);
+  report("i2c_transfers_per_press", simStats()->i2cTransfers / presses);
+}
+/*----------------------------------------------------------------------------*/
+static void runActiveBusError(struct Board *board, struct BoardModel *model)
+{
+  const uint64_t end = simTime() + RUN_TIME;
+  uint64_t latencyMax = 0;
+  uint64_t latencySum = 0;
+  unsigned long faults = 0;
+  unsigned long missed = 0;
+
+  while (simTime() < end)
+  {
+    /* Fault is longer than the codec check period */
+    model->codecFault = true;
+    simAdvance(MS(1500));
+    model->codecFault = false;
+    ++faults;
+
+    const uint64_t start = simTime();
+    const uint64_t timeout = start + MS(2500);
+
+    /* Recovery is finished when the bus retry counter is cleared */
+    while (board->system.retries && simTime() < timeout)
+      simAdvance(MS(1));
+
+    if (!board->system.retries)
+    {
+      const uint64_t latency = simTime() - start;
+
+      latencySum += latency;
+      if (latency > latencyMax)
+        latencyMax = latency;
+    }
+    else
+      ++missed;
+
+    simAdvance(timeout - simTime());
+  }
+
+  report("bus_faults", faults);
+  report("bus_missed", missed);
+  report("recovery_latency_avg_us", faults > missed ?
+      (unsigned long)(latencySum / (faults - missed)) : 0UL);
+  report("recovery_latency_max_us", (unsigned long)latencyMax);
+
+  /* Bus rate is raised back one step after each 30 quiet seconds */
+  const uint64_t timeout = simTime() + MS(70000);
+
+  while (board->codecPackage.rate != board->codecPackage.limit
+      && simTime() < timeout)
+  {
+    simAdvance(MS(100));
+  }
+
+  report("bus_rate_restored",
+      board->codecPackage.rate == board->codecPackage.limit);
+}
+/*----------------------------------------------------------------------------*/
+static void runIdle(struct Board *, struct BoardModel *)
+{
+  simAdvance(RUN_TIME);
+}
+/*----------------------------------------------------------------------------*/
+static void runSlaveAttention(struct Board *, struct BoardModel *)
+{
+  const uint64_t end = simTime() + RUN_TIME;
+  uint64_t toggle = simTime();
+  unsigned long requests = 0;
+  bool powered = true;
+
+  while (simTime() < end)
+  {
+    /* External supply is switched every second */
+    if (simTime() >= toggle)
+    {
+      powered = !powered;
+      modelSetSupply(powered ? SUPPLY_OK : 0);
+      toggle += MS(1000);
+    }
+
+    if (!simPinLevel(BOARD_ATTENTION_PIN))
+    {
+      const uint8_t acknowledge = 0;
+      uint8_t cause;
+      uint8_t status;
+
+      simSlaveRead(SLAVE_REG_CAUSE, &cause, sizeof(cause));
+      simSlaveRead(SLAVE_REG_STATUS, &status, sizeof(status));
+      simSlaveWrite(SLAVE_REG_CAUSE, &acknowledge, sizeof(acknowledge));
+      ++requests;
+    }
+
+    simAdvance(MS(1));
+  }
+
+  modelSetSupply(SUPPLY_OK);
+  report("attention_requests", requests);
+}
+/*----------------------------------------------------------------------------*/
+static void runSlaveLed(struct Board *, struct BoardModel *model)
+{
+  const uint64_t end = simTime() + RUN_TIME;
+  uint64_t latencyMax = 0;
+  uint64_t latencySum = 0;
+  unsigned long missed = 0;
+  unsigned long writes = 0;
+  uint8_t value = 0;
+
+  while (simTime() < end)
+  {
+    const uint64_t start = simTime();
+    const uint64_t timeout = start + MS(100);
+
+    value = (value + 1) & 0x0F;
+    simSlaveWrite(SLAVE_REG_LED, &value, sizeof(value));
+    ++writes;
+
+    /* Poll LED outputs with 100 us resolution */
+    while (model->led != value && simTime() < timeout)
+      simAdvance(100);
+
+    if (model->led == value)
+    {
+      const uint64_t latency = simTime() - start;
+
+      latencySum += latency;
+      if (latency > latencyMax)
+        latencyMax = latency;
+    }
+    else
+      ++missed;
+
+    simAdvance(timeout - simTime());
+  }
+
+  report("led_writes", writes);
+  report("led_missed", missed);
+  report("led_latency_avg_us", writes > missed ?
+      (unsigned long)(latencySum / (writes - missed)) : 0UL);
+  report("led_latency_max_us", (unsigned long)latencyMax);
+}
+/*----------------------------------------------------------------------------*/
+static void runSlavePoll(struct Board *, struct BoardModel *)
+{
+  const uint64_t end = simTime() + RUN_TIME;
+  unsigned long polls = 0;
+
+  while (simTime() < end)
+  {
+    uint8_t status;
+
+    simSlaveRead(SLAVE_REG_STATUS, &status, sizeof(status));
+    ++polls;
+    simAdvance(MS(20));
+  }
+
+  report("polls", polls);
+  report("spi_transfers_per_100_polls",
+      simStats()->spiTransfers * 100 / polls);
+}
+/*----------------------------------------------------------------------------*/
+static void runSlaveSave(struct Board *, struct BoardModel *)
+{
+  unsigned long failures = 0;
+
+  for (unsigned int i = 0; i < SAVE_COUNT; ++i)
+  {
+    /* Level differs from the stored one, otherwise nothing is written */
+    const uint8_t level = (uint8_t)(i * 5);
+    const uint64_t timeout = simTime() + MS(1000);
+    uint8_t sys;
+
+    simSlaveWrite(SLAVE_REG_MIC, &level, sizeof(level));
+    simSlaveRead(SLAVE_REG_SYS, &sys, sizeof(sys));
+    sys |= SLAVE_SYS_SAVE_CONFIG;
+    simSlaveWrite(SLAVE_REG_SYS, &sys, sizeof(sys));
+
+    /* Save flag is cleared by the firmware when the record is written */
+    do
+    {
+      simAdvance(MS(1));
+      simSlaveRead(SLAVE_REG_SYS, &sys, sizeof(sys));
+    }
+    while ((sys & SLAVE_SYS_SAVE_CONFIG) && simTime() < timeout);
+
+    if (sys & (SLAVE_SYS_SAVE_CONFIG | SLAVE_SYS_SAVE_ERROR))
+      ++failures;
+  }
+
+  report("saves", SAVE_COUNT);
+  report("save_failures", failures);
+}
+/*----------------------------------------------------------------------------*/
+static void runSlaveWindow(struct Board *, struct BoardModel *)
+{
+  static const uint8_t pages[] = {
+      SLAVE_PAGE_TELEMETRY,
+      SLAVE_PAGE_VERSION,
+      SLAVE_PAGE_DIAGNOSTIC
+  };
+  const struct BoardVersion * const version = getBoardVersion();
+  const uint64_t end = simTime() + RUN_TIME;
+  uint64_t latencyMax = 0;
+  unsigned long mismatched = 0;
+  unsigned long selections = 0;
+  unsigned long stale = 0;
+
+  while (simTime() < end)
+  {
+    const uint8_t page = pages[selections++ % ARRAY_SIZE(pages)];
+    const uint64_t start = simTime();
+    struct
+    {
+      struct SlaveWindowHeader header;
+      struct SlaveVersionPage version;
+    } window;
+
+    /* Write and read in one transaction return the previous window */
+    simSlaveWrite(SLAVE_REG_PAGE, &page, sizeof(page));
+    simSlaveRead(SLAVE_WINDOW_BASE, &window, sizeof(window));
+
+    if (window.header.page != page)
+      ++stale;
+
+    /* Window is read again in separate transactions with 100 us interval */
+    while (window.header.page != page && simTime() < start + MS(100))
+    {
+      simAdvance(100);
+      simSlaveRead(SLAVE_WINDOW_BASE, &window, sizeof(window));
+    }
+
+    const uint64_t latency = simTime() - start;
+
+    if (latency > latencyMax)
+      latencyMax = latency;
+
+    if (latency > SLAVE_WINDOW_TURNAROUND || window.header.page != page
+        || (page == SLAVE_PAGE_VERSION
+            && window.version.swMajor != (uint8_t)version->sw.major))
+    {
+      ++mismatched;
+    }
+
+    simAdvance(start + MS(100) - simTime());
+  }
+
+  report("window_selections", selections);
+  report("window_stale", stale);
+  report("window_mismatched", mismatched);
+  report("window_latency_max_us", (unsigned long)latencyMax);
+}
+/*----------------------------------------------------------------------------*/
+static void runSupplyNoise(struct Board *, struct BoardModel *)
+{
+  const uint64_t end = simTime() + RUN_TIME;
+  uint32_t seed = 1;
+
+  while (simTime() < end)
+  {
+    /* Deterministic noise within +/-64 mV around the threshold */
+    seed = seed * 1103515245 + 12345;
+    modelSetSupply(VOLTAGE_THRESHOLD - 64 + ((seed >> 16) & 0x7F));
+    simAdvance(MS(1));
+  }
+
+  modelSetSupply(SUPPLY_OK);
+}
+/*----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  scenario = &scenarios[0];
+
+  if (argc > 1)
+  {
+    scenario = NULL;
+
+    for (size_t i = 0; i < ARRAY_SIZE(scenarios); ++i)
+    {
+      if (!strcmp(argv[1], scenarios[i].name))
+      {
+        scenario = &scenarios[i];
+        break;
+      }
+    }
+
+    if (scenario == NULL)
+    {
+      fprintf(stderr, "Usage: %s [scenario]\n", argv[0]);
+      for (size_t i = 0; i < ARRAY_SIZE(scenarios); ++i)
+      {
+        fprintf(stderr, "  %-16s %s\n", scenarios[i].name,
+            scenarios[i].description);
+      }
+      return EXIT_FAILURE;
+    }
+  }
+
+  struct BoardModel * const model = malloc(sizeof(struct BoardModel));
+  struct Board * const board = malloc(sizeof(struct Board));
+
+  modelInit(model, scenario->sw, SUPPLY_OK);
+  appBoardInit(board);
+  invokeStartupTask(board);
+
+  simAdvance(BOOT_TIME);
+  simResetStats();
+
+  const uint64_t start = simTime();
+
+  scenario->run(board, model);
+  printStats(model, simTime() - start);
+
+  /* Regressions of the counters fail the run */
+  return checkLimits() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
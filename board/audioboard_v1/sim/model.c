@@ -0,0 +1,128 @@
+/*
+ * board/audioboard_v1/sim/model.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "model.h"
+#include "board_shared.h"
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Button is held longer than the debounce interval */
+#define BUTTON_HOLD_TIME    50000
+#define BUTTON_RELEASE_TIME 50000
+
+#define CODEC_REG_PAGE      0
+#define CODEC_REG_RESET     1
+#define CODEC_RESET_SOFT    0x80
+
+/* R1 = 20 kOhm, R2 = 10 kOhm, Vref = 3300 mV */
+#define SUPPLY_R1           20
+#define SUPPLY_R2           10
+#define SUPPLY_REF          3300
+/*----------------------------------------------------------------------------*/
+static size_t codecRead(struct SimI2CDevice *, void *, size_t);
+static size_t codecWrite(struct SimI2CDevice *, const void *, size_t);
+static uint8_t onControlBusExchange(void *, uint8_t);
+/*----------------------------------------------------------------------------*/
+static size_t codecRead(struct SimI2CDevice *device, void *buffer,
+    size_t length)
+{
+  struct BoardModel * const model = (struct BoardModel *)device;
+  uint8_t *position = buffer;
+
+  if (model->codecFault)
+    return 0;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    const uint8_t reg = model->codecPointer++ % MODEL_CODEC_REGS;
+
+    position[i] = reg == CODEC_REG_PAGE ?
+        model->codecPage : model->codecRegs[model->codecPage][reg];
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t codecWrite(struct SimI2CDevice *device, const void *buffer,
+    size_t length)
+{
+  struct BoardModel * const model = (struct BoardModel *)device;
+  const uint8_t *position = buffer;
+
+  if (!length || model->codecFault)
+    return 0;
+
+  /* First byte sets the register pointer, auto-increment is enabled */
+  model->codecPointer = position[0];
+
+  for (size_t i = 1; i < length; ++i)
+  {
+    const uint8_t reg = model->codecPointer++ % MODEL_CODEC_REGS;
+    const uint8_t value = position[i];
+
+    if (reg == CODEC_REG_PAGE)
+    {
+      model->codecPage = value % MODEL_CODEC_PAGES;
+    }
+    else if (model->codecPage == 0 && reg == CODEC_REG_RESET
+        && (value & CODEC_RESET_SOFT))
+    {
+      memset(model->codecRegs, 0, sizeof(model->codecRegs));
+      model->codecPage = 0;
+    }
+    else
+    {
+      model->codecRegs[model->codecPage][reg] = value;
+    }
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t onControlBusExchange(void *argument, uint8_t value)
+{
+  struct BoardModel * const model = argument;
+  uint8_t response = 0xFF;
+
+  /* LED shift register is selected by the low level */
+  if (!simPinLevel(BOARD_SPI_CS0_PIN))
+    model->led = value;
+
+  /* Switch shift register outputs are enabled by the high level */
+  if (simPinLevel(BOARD_SPI_CS1_PIN))
+    response = model->sw;
+
+  return response;
+}
+/*----------------------------------------------------------------------------*/
+void modelInit(struct BoardModel *model, uint8_t sw, uint32_t voltage)
+{
+  memset(model, 0, sizeof(*model));
+
+  model->codec.read = codecRead;
+  model->codec.write = codecWrite;
+  model->codec.address = MODEL_CODEC_ADDRESS;
+  model->sw = sw;
+
+  simI2CAttach(&model->codec);
+  simSpiSetHandler(onControlBusExchange, model);
+  modelSetSupply(voltage);
+}
+/*----------------------------------------------------------------------------*/
+void modelPressButton(PinNumber key)
+{
+  simPinDrive(key, false);
+  simAdvance(BUTTON_HOLD_TIME);
+  simPinDrive(key, true);
+  simAdvance(BUTTON_RELEASE_TIME);
+}
+/*----------------------------------------------------------------------------*/
+void modelSetSupply(uint32_t voltage)
+{
+  const uint64_t sample = ((uint64_t)voltage << 16) * SUPPLY_R2
+      / (SUPPLY_REF * (SUPPLY_R1 + SUPPLY_R2));
+
+  simAdcSetValue(sample > UINT16_MAX ? UINT16_MAX : (uint16_t)sample);
+}
@@ -0,0 +1,41 @@
+/*
+ * board/audioboard_v1/sim/model.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef BOARD_AUDIOBOARD_V1_SIM_MODEL_H_
+#define BOARD_AUDIOBOARD_V1_SIM_MODEL_H_
+/*----------------------------------------------------------------------------*/
+#include <sim.h>
+/*----------------------------------------------------------------------------*/
+#define MODEL_CODEC_ADDRESS   0x18
+#define MODEL_CODEC_PAGES     2
+#define MODEL_CODEC_REGS      128
+
+struct BoardModel
+{
+  struct SimI2CDevice codec;
+
+  /* Register file of the TLV320AIC3104 */
+  uint8_t codecRegs[MODEL_CODEC_PAGES][MODEL_CODEC_REGS];
+  uint8_t codecPage;
+  uint8_t codecPointer;
+  /* Codec does not acknowledge transfers */
+  bool codecFault;
+
+  /* Outputs of the LED shift register */
+  uint8_t led;
+  /* Inputs of the switch shift register */
+  uint8_t sw;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void modelInit(struct BoardModel *, uint8_t, uint32_t);
+void modelPressButton(PinNumber);
+void modelSetSupply(uint32_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* BOARD_AUDIOBOARD_V1_SIM_MODEL_H_ */
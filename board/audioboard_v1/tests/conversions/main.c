@@ -0,0 +1,368 @@
+/*
+ * board/audioboard_v1/tests/conversions/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "board_shared.h"
+#include "controls.h"
+#include "conversions.h"
+#include <halm/timer.h>
+#include <xcore/helpers.h>
+#include <xcore/interface.h>
+#include <xcore/memory.h>
+#include <assert.h>
+#include <stdio.h>
+/*----------------------------------------------------------------------------*/
+#define ITERATIONS 100
+/* Reported mismatches of each conversion, the rest are only counted */
+#define MAX_REPORTS 4
+
+struct Benchmark
+{
+  const char *name;
+  /* Comparison with the original formulas for all inputs */
+  unsigned int (*verify)(struct Interface *);
+  /* Conversions with library division */
+  void (*reference)(void);
+  /* Conversions with lookup tables and precomputed constants */
+  void (*optimized)(void);
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t measure(struct Timer *, void (*)(void));
+static uint8_t originalGainToLevel(uint8_t);
+static uint8_t originalLevelToBar(uint8_t);
+static uint8_t originalLevelToGain(uint8_t);
+static uint32_t originalSampleToVoltage(uint32_t);
+static void print(struct Interface *, const char *, size_t);
+static void reportMismatch(struct Interface *, const char *, unsigned int,
+    uint32_t, uint32_t, uint32_t);
+static unsigned int verifyGainToLevel(struct Interface *);
+static unsigned int verifyLevelToBar(struct Interface *);
+static unsigned int verifyLevelToGain(struct Interface *);
+static unsigned int verifyVoltage(struct Interface *);
+
+static void gainToLevelOptimized(void);
+static void gainToLevelReference(void);
+static void levelToBarOptimized(void);
+static void levelToBarReference(void);
+static void levelToGainOptimized(void);
+static void levelToGainReference(void);
+static void voltageOptimized(void);
+static void voltageReference(void);
+/*----------------------------------------------------------------------------*/
+static const struct Benchmark benchmarks[] = {
+    {
+        "gain_to_level",
+        verifyGainToLevel,
+        gainToLevelReference,
+        gainToLevelOptimized
+    }, {
+        "level_to_bar",
+        verifyLevelToBar,
+        levelToBarReference,
+        levelToBarOptimized
+    }, {
+        "level_to_gain",
+        verifyLevelToGain,
+        levelToGainReference,
+        levelToGainOptimized
+    }, {
+        "voltage",
+        verifyVoltage,
+        voltageReference,
+        voltageOptimized
+    }
+};
+
+/* Results are stored to prevent removal of the conversions */
+static volatile uint8_t sink;
+/*----------------------------------------------------------------------------*/
+static uint32_t measure(struct Timer *timer, void (*benchmark)(void))
+{
+  const uint32_t start = timerGetValue(timer);
+
+  for (size_t i = 0; i < ITERATIONS; ++i)
+    benchmark();
+
+  return timerGetValue(timer) - start;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t originalGainToLevel(uint8_t gain)
+{
+  return gain * LEVEL_MAX / 255;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t originalLevelToBar(uint8_t level)
+{
+  uint8_t result = 0;
+
+  switch ((level + 1) / 2)
+  {
+    case 4:
+      result |= 0x01;
+      [[fallthrough]];
+    case 3:
+      result |= 0x02;
+      [[fallthrough]];
+    case 2:
+      result |= 0x04;
+      [[fallthrough]];
+    case 1:
+      result |= 0x08;
+      break;
+
+    default:
+      break;
+  }
+
+  return result;
+}
+/*----------------------------------------------------------------------------*/
+static uint8_t originalLevelToGain(uint8_t level)
+{
+  return level * 255 / LEVEL_MAX;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t originalSampleToVoltage(uint32_t sample)
+{
+  /* R1 = 20 kOhm, R2 = 10 kOhm, Vref = 3300 mV */
+  static const uint64_t r1Value = 20;
+  static const uint64_t r2Value = 10;
+  static const uint64_t refVoltage = 3300;
+
+  /* Product is 64-bit wide, 32-bit one overflows for samples above 6.5 V */
+  return (uint32_t)(((sample * refVoltage * (r1Value + r2Value)) / r2Value)
+      >> 16);
+}
+/*----------------------------------------------------------------------------*/
+static void print(struct Interface *serial, const char *text, size_t length)
+{
+  /* Wait for free space in the transmit buffer */
+  while (length)
+  {
+    const size_t written = ifWrite(serial, text, length);
+
+    text += written;
+    length -= written;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void reportMismatch(struct Interface *serial, const char *name,
+    unsigned int count, uint32_t input, uint32_t expected, uint32_t actual)
+{
+  if (count >= MAX_REPORTS)
+    return;
+
+  char text[64];
+  const int length = sprintf(text, "%s(%lu): expected %lu, got %lu\r\n",
+      name, (unsigned long)input, (unsigned long)expected,
+      (unsigned long)actual);
+
+  print(serial, text, (size_t)length);
+}
+/*----------------------------------------------------------------------------*/
+static unsigned int verifyGainToLevel(struct Interface *serial)
+{
+  unsigned int mismatches = 0;
+
+  for (unsigned int gain = 0; gain <= UINT8_MAX; ++gain)
+  {
+    const uint8_t expected = originalGainToLevel((uint8_t)gain);
+    const uint8_t actual = gainToLevel((uint8_t)gain);
+
+    if (actual != expected)
+    {
+      reportMismatch(serial, "gain_to_level", mismatches, gain,
+          expected, actual);
+      ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+/*----------------------------------------------------------------------------*/
+static unsigned int verifyLevelToBar(struct Interface *serial)
+{
+  unsigned int mismatches = 0;
+
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+  {
+    const uint8_t expected = originalLevelToBar(level);
+    const uint8_t actual = levelToBar(level);
+
+    if (actual != expected)
+    {
+      reportMismatch(serial, "level_to_bar", mismatches, level,
+          expected, actual);
+      ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+/*----------------------------------------------------------------------------*/
+static unsigned int verifyLevelToGain(struct Interface *serial)
+{
+  unsigned int mismatches = 0;
+
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+  {
+    const uint8_t expected = originalLevelToGain(level);
+    const uint8_t actual = levelToGain(level);
+
+    if (actual != expected)
+    {
+      reportMismatch(serial, "level_to_gain", mismatches, level,
+          expected, actual);
+      ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+/*----------------------------------------------------------------------------*/
+static unsigned int verifyVoltage(struct Interface *serial)
+{
+  const uint32_t limit = originalSampleToVoltage(UINT16_MAX);
+  unsigned int mismatches = 0;
+
+  for (uint32_t sample = 0; sample <= UINT16_MAX; ++sample)
+  {
+    const uint32_t expected = originalSampleToVoltage(sample);
+    const uint32_t actual = SAMPLE_TO_VOLTAGE(sample);
+
+    if (actual != expected)
+    {
+      reportMismatch(serial, "sample_to_voltage", mismatches, sample,
+          expected, actual);
+      ++mismatches;
+    }
+  }
+
+  /* Threshold in samples is the first sample at or above the voltage */
+  for (uint32_t voltage = 0, expected = 0; voltage <= limit; ++voltage)
+  {
+    while (originalSampleToVoltage(expected) < voltage)
+      ++expected;
+
+    const uint32_t actual = VOLTAGE_TO_SAMPLE(voltage);
+
+    if (actual != expected)
+    {
+      reportMismatch(serial, "voltage_to_sample", mismatches, voltage,
+          expected, actual);
+      ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+/*----------------------------------------------------------------------------*/
+static void gainToLevelOptimized(void)
+{
+  for (unsigned int gain = 0; gain <= UINT8_MAX; ++gain)
+    sink = gainToLevel((uint8_t)gain);
+}
+/*----------------------------------------------------------------------------*/
+static void gainToLevelReference(void)
+{
+  for (unsigned int gain = 0; gain <= UINT8_MAX; ++gain)
+    sink = originalGainToLevel((uint8_t)gain);
+}
+/*----------------------------------------------------------------------------*/
+static void levelToBarOptimized(void)
+{
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+    sink = levelToBar(level);
+}
+/*----------------------------------------------------------------------------*/
+static void levelToBarReference(void)
+{
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+    sink = originalLevelToBar(level);
+}
+/*----------------------------------------------------------------------------*/
+static void levelToGainOptimized(void)
+{
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+    sink = levelToGain(level);
+}
+/*----------------------------------------------------------------------------*/
+static void levelToGainReference(void)
+{
+  for (uint8_t level = LEVEL_MIN; level <= LEVEL_MAX; ++level)
+    sink = originalLevelToGain(level);
+}
+/*----------------------------------------------------------------------------*/
+static void voltageOptimized(void)
+{
+  static const uint16_t threshold = VOLTAGE_TO_SAMPLE(VOLTAGE_THRESHOLD);
+
+  for (uint32_t sample = 0; sample <= UINT16_MAX; sample += 256)
+    sink = sample >= threshold;
+}
+/*----------------------------------------------------------------------------*/
+static void voltageReference(void)
+{
+  /* R1 = 20 kOhm, R2 = 10 kOhm, Vref = 3300 mV */
+  static const uint32_t r1Value = 20;
+  static const uint32_t r2Value = 10;
+  static const uint32_t refVoltage = 3300;
+
+  for (uint32_t sample = 0; sample <= UINT16_MAX; sample += 256)
+  {
+    const uint32_t voltage =
+        ((sample * refVoltage * (r1Value + r2Value)) / r2Value) >> 16;
+
+    sink = voltage >= VOLTAGE_THRESHOLD;
+  }
+}
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  boardSetupClock();
+
+  struct Interface * const serial = boardMakeSerial();
+  struct Timer * const timer = boardMakeAdcTimer();
+
+  unsigned int mismatches = 0;
+  char text[64];
+  int length;
+
+  /* Timing results are printed only when all conversions are equivalent */
+  for (size_t i = 0; i < ARRAY_SIZE(benchmarks); ++i)
+    mismatches += benchmarks[i].verify(serial);
+
+  length = sprintf(text, "verification: %u mismatches, %s\r\n", mismatches,
+      mismatches ? "FAIL" : "PASS");
+  print(serial, text, (size_t)length);
+
+  while (mismatches)
+    barrier();
+
+  timerEnable(timer);
+
+  while (1)
+  {
+    for (size_t i = 0; i < ARRAY_SIZE(benchmarks); ++i)
+    {
+      /* Timer frequency is 1 MHz, results are in microseconds */
+      const uint32_t reference = measure(timer, benchmarks[i].reference);
+      const uint32_t optimized = measure(timer, benchmarks[i].optimized);
+
+      length = sprintf(text, "%s: %lu %lu\r\n", benchmarks[i].name,
+          (unsigned long)reference, (unsigned long)optimized);
+      print(serial, text, (size_t)length);
+    }
+
+    /* Wait for the transmission to finish */
+    for (uint32_t start = timerGetValue(timer);
+        timerGetValue(timer) - start < 1000000;)
+    {
+      barrier();
+    }
+  }
+
+  return 0;
+}
@@ -125,14 +125,16 @@ int main(void)
   boardSetupClock();
 
   struct Interface * const i2c = boardMakeI2CMaster();
+  const uint32_t rate = boardProbeCodecRate(i2c);
+  struct CodecCache * const cache = boardMakeCodecCache(NULL, i2c);
 
   struct Interface * const serial = boardMakeSerial();
   ifSetCallback(serial, onSerialEvent, &event);
 
   const struct CodecConfig codecConfig = {
-      .interface = i2c,
+      .interface = (struct Interface *)cache,
       .address = 0,
-      .rate = 0,
+      .rate = rate,
       .amp = BOARD_AMP_POWER_PIN,
       .gain0 = BOARD_AMP_GAIN0_PIN,
       .gain1 = BOARD_AMP_GAIN1_PIN,
@@ -0,0 +1,56 @@
+/*
+ * arena.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "arena.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define ARENA_ALIGNMENT alignof(max_align_t)
+/*----------------------------------------------------------------------------*/
+void *_sbrk(ptrdiff_t);
+/*----------------------------------------------------------------------------*/
+static bool sealed = false;
+/*----------------------------------------------------------------------------*/
+void arenaSeal(void)
+{
+  sealed = true;
+}
+/*----------------------------------------------------------------------------*/
+void *calloc(size_t number, size_t size)
+{
+  if (size && number > SIZE_MAX / size)
+    return NULL;
+
+  void * const block = malloc(number * size);
+
+  if (block != NULL)
+    memset(block, 0, number * size);
+
+  return block;
+}
+/*----------------------------------------------------------------------------*/
+void free(void *)
+{
+  /* Objects are allocated once during initialization and never released */
+}
+/*----------------------------------------------------------------------------*/
+void *malloc(size_t size)
+{
+  assert(!sealed);
+
+  if (sealed || size > PTRDIFF_MAX - ARENA_ALIGNMENT)
+    return NULL;
+
+  /* Program break is aligned by the linker script and kept aligned */
+  const size_t aligned = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+  void * const block = _sbrk((ptrdiff_t)aligned);
+
+  return block != (void *)-1 ? block : NULL;
+}
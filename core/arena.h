@@ -0,0 +1,18 @@
+/*
+ * core/arena.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_ARENA_H_
+#define CORE_ARENA_H_
+/*----------------------------------------------------------------------------*/
+/*
+ * Standard allocation functions are replaced with a bump allocator placed
+ * in the heap region of the linker script. Blocks have no headers and are
+ * never released. After sealing, any allocation fails with an assertion
+ * and a null pointer is returned.
+ */
+void arenaSeal(void);
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_ARENA_H_ */
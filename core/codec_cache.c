@@ -0,0 +1,1007 @@
+/*
+ * codec_cache.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "codec_cache.h"
+#include <halm/generic/i2c.h>
+#include <halm/wq.h>
+#include <xcore/bits.h>
+#include <xcore/helpers.h>
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define REG_PAGE_SELECT   0
+#define REG_SOFT_RESET    1
+#define SOFT_RESET_BIT    BIT(7)
+
+#define IMAGE_SIZE        (CODEC_CACHE_PAGES * CODEC_CACHE_REGS)
+
+static_assert(CONFIG_CODEC_CACHE_WINDOW <= CONFIG_CODEC_CACHE_BURST,
+    "Verification window should fit in the write buffer");
+
+enum State
+{
+  STATE_IDLE,
+  STATE_DEFERRED,
+  STATE_POINTER,
+  STATE_READ,
+  STATE_WRITE,
+  STATE_PASSTHROUGH,
+  STATE_FLUSH,
+  STATE_VERIFY_PAGE,
+  STATE_VERIFY_POINTER,
+  STATE_VERIFY_READ,
+  STATE_VERIFY_WRITE
+};
+/*----------------------------------------------------------------------------*/
+static bool absorbWrite(struct CodecCache *, const uint8_t *, size_t);
+static bool cacheable(const struct CodecCache *, uint8_t);
+static void commitRead(struct CodecCache *);
+static void commitWrite(struct CodecCache *);
+static bool complete(struct CodecCache *);
+static bool findWindow(struct CodecCache *);
+static void finishFlush(struct CodecCache *, bool);
+static void finishVerification(struct CodecCache *, bool);
+static void flushBlocking(struct CodecCache *);
+static bool flushNextRun(struct CodecCache *);
+static bool isDirty(const struct CodecCache *);
+static bool isIndexDirty(const struct CodecCache *, unsigned int);
+static bool isIndexValid(const struct CodecCache *, unsigned int);
+static bool isRegValid(const struct CodecCache *, uint8_t);
+static void markStale(struct CodecCache *);
+static size_t postponeWrite(struct CodecCache *, const uint8_t *, size_t);
+static size_t readFromBus(struct CodecCache *);
+static void resumeFlush(struct CodecCache *);
+static bool resyncWindow(struct CodecCache *);
+static bool scheduleFlush(struct CodecCache *);
+static bool startVerification(struct CodecCache *);
+static bool startWindowRead(struct CodecCache *);
+static void storeReg(struct CodecCache *, uint8_t, uint8_t);
+static size_t takeDirtyRun(struct CodecCache *);
+static size_t writeToBus(struct CodecCache *, const uint8_t *, size_t);
+static void onBusEvent(void *);
+static void onDeferredEvent(void *);
+static void onFlushEvent(struct CodecCache *);
+static void onPendingEvent(void *);
+static void onVerifyEvent(struct CodecCache *);
+
+static enum Result cacheInit(void *, const void *);
+static void cacheSetCallback(void *, void (*)(void *), void *);
+static enum Result cacheGetParam(void *, int, void *);
+static enum Result cacheSetParam(void *, int, const void *);
+static size_t cacheRead(void *, void *, size_t);
+static size_t cacheWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const CodecCache =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct CodecCache),
+    .init = cacheInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = cacheSetCallback,
+    .getParam = cacheGetParam,
+    .setParam = cacheSetParam,
+    .read = cacheRead,
+    .write = cacheWrite
+};
+/*----------------------------------------------------------------------------*/
+/* Status and interrupt flag registers of the first page */
+static const uint32_t volatileRegs[CODEC_CACHE_REGS / 32] = {
+    BIT(REG_SOFT_RESET) | BIT(11),
+    0,
+    BIT(94 - 64) | BIT(95 - 64),
+    BIT(96 - 96) | BIT(97 - 96)
+};
+/*----------------------------------------------------------------------------*/
+static bool absorbWrite(struct CodecCache *cache, const uint8_t *data,
+    size_t length)
+{
+  const uint8_t reg = data[0];
+
+  if (reg == REG_PAGE_SELECT)
+  {
+    /* Selection of the current page is dropped */
+    return length == 2 && data[1] == cache->page;
+  }
+
+  if (reg + length - 1 > CODEC_CACHE_REGS)
+    return false;
+
+  bool changed = false;
+
+  for (size_t i = 1; i < length; ++i)
+  {
+    const uint8_t current = (uint8_t)(reg + i - 1);
+
+    if (!cacheable(cache, current))
+      return false;
+
+    if (!isRegValid(cache, current)
+        || cache->image[cache->page][current] != data[i])
+    {
+      changed = true;
+    }
+  }
+
+  if (!changed)
+    return true;
+
+  for (size_t i = 1; i < length; ++i)
+  {
+    const uint8_t current = (uint8_t)(reg + i - 1);
+    const unsigned int index = cache->page * CODEC_CACHE_REGS + current;
+
+    if (!isIndexValid(cache, index)
+        || cache->image[cache->page][current] != data[i])
+    {
+      cache->image[cache->page][current] = data[i];
+      cache->valid[index >> 5] |= BIT(index & 31);
+      cache->dirty[index >> 5] |= BIT(index & 31);
+    }
+  }
+
+  /* Flush is started after the completion of this write */
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool cacheable(const struct CodecCache *cache, uint8_t reg)
+{
+  if (cache->page >= CODEC_CACHE_PAGES || reg >= CODEC_CACHE_REGS)
+    return false;
+  if (cache->page == 0 && (volatileRegs[reg >> 5] & BIT(reg & 31)))
+    return false;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void commitRead(struct CodecCache *cache)
+{
+  for (size_t i = 0; i < cache->rxLength; ++i)
+    storeReg(cache, (uint8_t)(cache->pointer + i), cache->rxBuffer[i]);
+}
+/*----------------------------------------------------------------------------*/
+static void commitWrite(struct CodecCache *cache)
+{
+  const uint8_t reg = cache->txBuffer[0];
+
+  for (size_t i = 1; i < cache->txLength; ++i)
+    storeReg(cache, (uint8_t)(reg + i - 1), cache->txBuffer[i]);
+}
+/*----------------------------------------------------------------------------*/
+static bool complete(struct CodecCache *cache)
+{
+  if (cache->blocking)
+  {
+    cache->state = STATE_IDLE;
+    cache->status = E_OK;
+    return true;
+  }
+
+  cache->state = STATE_DEFERRED;
+
+  if (wqAdd(cache->wq, onDeferredEvent, cache) == E_OK)
+  {
+    return true;
+  }
+  else
+  {
+    cache->state = STATE_IDLE;
+    return false;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool findWindow(struct CodecCache *cache)
+{
+  /* Resynchronization stops after one pass over the image */
+  const unsigned int limit = cache->resync ? cache->sweep : IMAGE_SIZE;
+
+  for (unsigned int i = 0; i < limit; ++i)
+  {
+    const unsigned int index = (cache->cursor + i) % IMAGE_SIZE;
+
+    if (isIndexValid(cache, index))
+    {
+      unsigned int end = index + 1;
+
+      /* Window is a run of known registers within one page */
+      while (end - index < CONFIG_CODEC_CACHE_WINDOW
+          && end % CODEC_CACHE_REGS != 0 && isIndexValid(cache, end))
+      {
+        ++end;
+      }
+
+      const unsigned int consumed = i + end - index;
+
+      cache->origin = (uint8_t)index;
+      cache->span = (uint8_t)(end - index);
+      cache->cursor = (uint16_t)(end % IMAGE_SIZE);
+      cache->sweep = consumed < cache->sweep ?
+          (uint16_t)(cache->sweep - consumed) : 0;
+      return true;
+    }
+  }
+
+  return false;
+}
+/*----------------------------------------------------------------------------*/
+static void finishFlush(struct CodecCache *cache, bool ok)
+{
+  if (!ok)
+    markStale(cache);
+
+  if (cache->owned)
+  {
+    if (cache->address != cache->codec)
+      ifSetParam(cache->bus, IF_ADDRESS, &cache->address);
+
+    cache->owned = false;
+    ifSetParam(cache->bus, IF_RELEASE, NULL);
+  }
+
+  cache->state = STATE_IDLE;
+
+  if (cache->postponed)
+  {
+    cache->postponed = false;
+
+    if (!writeToBus(cache, cache->txBuffer, cache->txLength))
+    {
+      cache->status = E_ERROR;
+
+      if (cache->callback != NULL)
+        cache->callback(cache->argument);
+    }
+  }
+  else
+    resumeFlush(cache);
+}
+/*----------------------------------------------------------------------------*/
+static void finishVerification(struct CodecCache *cache, bool ok)
+{
+  if (ok && cache->resync)
+  {
+    /* Windows of the resynchronization are checked in one bus session */
+    if (cache->sweep && findWindow(cache))
+    {
+      if (startVerification(cache))
+        return;
+
+      ok = false;
+    }
+    else
+      cache->stale = false;
+  }
+
+  cache->resync = false;
+
+  if (!ok)
+    markStale(cache);
+
+  if (cache->address != cache->codec)
+    ifSetParam(cache->bus, IF_ADDRESS, &cache->address);
+
+  cache->state = STATE_IDLE;
+  ifSetParam(cache->bus, IF_RELEASE, NULL);
+
+  resumeFlush(cache);
+}
+/*----------------------------------------------------------------------------*/
+static void flushBlocking(struct CodecCache *cache)
+{
+  if (!isDirty(cache))
+    return;
+
+  ifSetParam(cache->bus, IF_ADDRESS, &cache->codec);
+
+  size_t length;
+
+  while ((length = takeDirtyRun(cache)) != 0)
+  {
+    if (ifWrite(cache->bus, cache->trimmed, length) != length)
+    {
+      markStale(cache);
+      break;
+    }
+  }
+
+  if (cache->address != cache->codec)
+    ifSetParam(cache->bus, IF_ADDRESS, &cache->address);
+}
+/*----------------------------------------------------------------------------*/
+static bool flushNextRun(struct CodecCache *cache)
+{
+  const size_t length = takeDirtyRun(cache);
+
+  if (!length)
+    return false;
+
+  cache->state = STATE_FLUSH;
+
+  if (ifWrite(cache->bus, cache->trimmed, length))
+    return true;
+
+  markStale(cache);
+  return false;
+}
+/*----------------------------------------------------------------------------*/
+static bool isDirty(const struct CodecCache *cache)
+{
+  for (size_t i = 0; i < ARRAY_SIZE(cache->dirty); ++i)
+  {
+    if (cache->dirty[i])
+      return true;
+  }
+
+  return false;
+}
+/*----------------------------------------------------------------------------*/
+static bool isIndexDirty(const struct CodecCache *cache, unsigned int index)
+{
+  return (cache->dirty[index >> 5] & BIT(index & 31)) != 0;
+}
+/*----------------------------------------------------------------------------*/
+static bool isIndexValid(const struct CodecCache *cache, unsigned int index)
+{
+  return (cache->valid[index >> 5] & BIT(index & 31)) != 0;
+}
+/*----------------------------------------------------------------------------*/
+static bool isRegValid(const struct CodecCache *cache, uint8_t reg)
+{
+  /* Stale values are neither returned nor used to drop writes */
+  if (cache->stale || !cacheable(cache, reg))
+    return false;
+
+  return isIndexValid(cache, cache->page * CODEC_CACHE_REGS + reg);
+}
+/*----------------------------------------------------------------------------*/
+static void markStale(struct CodecCache *cache)
+{
+  /*
+   * Expected register values are kept, pending writes are restored later
+   * by the resynchronization, the current page is unknown.
+   */
+  memset(cache->dirty, 0, sizeof(cache->dirty));
+  cache->page = CODEC_CACHE_PAGES;
+  cache->stale = true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t postponeWrite(struct CodecCache *cache, const uint8_t *buffer,
+    size_t length)
+{
+  /* Write is sent after the pending writes to keep the order */
+  cache->txBuffer = buffer;
+  cache->txLength = length;
+  cache->postponed = true;
+
+  if (flushNextRun(cache))
+    return length;
+
+  cache->postponed = false;
+  return writeToBus(cache, buffer, length);
+}
+/*----------------------------------------------------------------------------*/
+static size_t readFromBus(struct CodecCache *cache)
+{
+  size_t count;
+
+  cache->state = STATE_POINTER;
+
+  ifSetParam(cache->bus, IF_I2C_REPEATED_START, NULL);
+  count = ifWrite(cache->bus, &cache->pointer, 1);
+
+  if (count != 1)
+  {
+    cache->state = STATE_IDLE;
+    cache->status = E_ERROR;
+    return 0;
+  }
+
+  if (!cache->blocking)
+    return cache->rxLength;
+
+  count = ifRead(cache->bus, cache->rxBuffer, cache->rxLength);
+  cache->state = STATE_IDLE;
+
+  if (count == cache->rxLength)
+  {
+    commitRead(cache);
+    cache->status = E_OK;
+  }
+  else
+  {
+    markStale(cache);
+    cache->status = E_ERROR;
+  }
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static void resumeFlush(struct CodecCache *cache)
+{
+  /* Pending writes are flushed each time the bus becomes free */
+  if (!cache->blocking && cache->state == STATE_IDLE && isDirty(cache))
+    scheduleFlush(cache);
+}
+/*----------------------------------------------------------------------------*/
+static bool resyncWindow(struct CodecCache *cache)
+{
+  const uint8_t page = cache->origin / CODEC_CACHE_REGS;
+  const uint8_t reg = cache->origin % CODEC_CACHE_REGS;
+  const uint8_t * const expected = &cache->image[page][reg];
+  size_t first = cache->span;
+  size_t last = 0;
+
+  for (size_t i = 0; i < cache->span; ++i)
+  {
+    if (cache->window[i] != expected[i])
+    {
+      if (first == cache->span)
+        first = i;
+      last = i;
+    }
+  }
+
+  if (first > last)
+    return false;
+
+  /* Restore only the registers that drifted */
+  const size_t span = last - first + 1;
+
+  cache->trimmed[0] = (uint8_t)(reg + first);
+  memcpy(cache->trimmed + 1, expected + first, span);
+
+  cache->state = STATE_VERIFY_WRITE;
+  return ifWrite(cache->bus, cache->trimmed, span + 1) != 0;
+}
+/*----------------------------------------------------------------------------*/
+static bool scheduleFlush(struct CodecCache *cache)
+{
+  if (!cache->scheduled)
+    cache->scheduled = wqAdd(cache->wq, onPendingEvent, cache) == E_OK;
+
+  return cache->scheduled;
+}
+/*----------------------------------------------------------------------------*/
+static bool startVerification(struct CodecCache *cache)
+{
+  const uint8_t page = cache->origin / CODEC_CACHE_REGS;
+
+  if (page != cache->page)
+  {
+    cache->trimmed[0] = REG_PAGE_SELECT;
+    cache->trimmed[1] = page;
+    cache->state = STATE_VERIFY_PAGE;
+
+    return ifWrite(cache->bus, cache->trimmed, 2) != 0;
+  }
+  else
+    return startWindowRead(cache);
+}
+/*----------------------------------------------------------------------------*/
+static bool startWindowRead(struct CodecCache *cache)
+{
+  cache->trimmed[0] = cache->origin % CODEC_CACHE_REGS;
+  cache->state = STATE_VERIFY_POINTER;
+
+  ifSetParam(cache->bus, IF_I2C_REPEATED_START, NULL);
+  return ifWrite(cache->bus, cache->trimmed, 1) != 0;
+}
+/*----------------------------------------------------------------------------*/
+static void storeReg(struct CodecCache *cache, uint8_t reg, uint8_t value)
+{
+  if (reg == REG_PAGE_SELECT)
+  {
+    cache->page = value < CODEC_CACHE_PAGES ? value : CODEC_CACHE_PAGES;
+  }
+  else if (cache->page == 0 && reg == REG_SOFT_RESET)
+  {
+    if (value & SOFT_RESET_BIT)
+    {
+      /* All registers return to unknown defaults, page 0 is selected */
+      codecCacheInvalidate(cache);
+      cache->page = 0;
+    }
+  }
+  else if (cacheable(cache, reg))
+  {
+    const unsigned int index = cache->page * CODEC_CACHE_REGS + reg;
+
+    cache->image[cache->page][reg] = value;
+    cache->valid[index >> 5] |= BIT(index & 31);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t takeDirtyRun(struct CodecCache *cache)
+{
+  if (cache->page >= CODEC_CACHE_PAGES)
+    return 0;
+
+  const unsigned int base = cache->page * CODEC_CACHE_REGS;
+
+  for (unsigned int reg = 0; reg < CODEC_CACHE_REGS; ++reg)
+  {
+    if (!isIndexDirty(cache, base + reg))
+      continue;
+
+    unsigned int end = reg + 1;
+
+    /* Adjacent registers are written in one auto-increment burst */
+    while (end - reg < CONFIG_CODEC_CACHE_BURST && end < CODEC_CACHE_REGS
+        && isIndexDirty(cache, base + end))
+    {
+      ++end;
+    }
+
+    cache->trimmed[0] = (uint8_t)reg;
+    memcpy(cache->trimmed + 1, &cache->image[cache->page][reg], end - reg);
+
+    for (unsigned int index = base + reg; index < base + end; ++index)
+      cache->dirty[index >> 5] &= ~BIT(index & 31);
+
+    return end - reg + 1;
+  }
+
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static size_t writeToBus(struct CodecCache *cache, const uint8_t *buffer,
+    size_t length)
+{
+  size_t count;
+
+  cache->txBuffer = buffer;
+  cache->txLength = length;
+  cache->state = STATE_WRITE;
+
+  count = ifWrite(cache->bus, buffer, length);
+
+  if (cache->blocking)
+  {
+    cache->state = STATE_IDLE;
+
+    if (count == length)
+    {
+      commitWrite(cache);
+      cache->status = E_OK;
+    }
+    else
+    {
+      markStale(cache);
+      cache->status = E_ERROR;
+    }
+  }
+  else if (!count)
+    cache->state = STATE_IDLE;
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static void onBusEvent(void *argument)
+{
+  struct CodecCache * const cache = argument;
+
+  /* Blocking transfers are finished in the calling context */
+  if (cache->blocking || cache->state == STATE_IDLE)
+    return;
+
+  if (cache->state == STATE_FLUSH)
+  {
+    onFlushEvent(cache);
+    return;
+  }
+
+  if (cache->state >= STATE_VERIFY_PAGE)
+  {
+    onVerifyEvent(cache);
+    return;
+  }
+
+  enum Result status = ifGetParam(cache->bus, IF_STATUS, NULL);
+
+  if (status == E_OK)
+  {
+    switch ((enum State)cache->state)
+    {
+      case STATE_POINTER:
+        cache->state = STATE_READ;
+
+        if (ifRead(cache->bus, cache->rxBuffer, cache->rxLength))
+          return;
+
+        status = E_ERROR;
+        break;
+
+      case STATE_READ:
+        commitRead(cache);
+        break;
+
+      case STATE_WRITE:
+        commitWrite(cache);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  if (status != E_OK && cache->state != STATE_PASSTHROUGH)
+    markStale(cache);
+
+  cache->state = STATE_IDLE;
+  cache->status = status;
+
+  if (cache->callback != NULL)
+    cache->callback(cache->argument);
+
+  resumeFlush(cache);
+}
+/*----------------------------------------------------------------------------*/
+static void onDeferredEvent(void *argument)
+{
+  struct CodecCache * const cache = argument;
+
+  cache->state = STATE_IDLE;
+  cache->status = E_OK;
+
+  if (cache->callback != NULL)
+    cache->callback(cache->argument);
+
+  resumeFlush(cache);
+}
+/*----------------------------------------------------------------------------*/
+static void onFlushEvent(struct CodecCache *cache)
+{
+  const bool ok = ifGetParam(cache->bus, IF_STATUS, NULL) == E_OK;
+
+  if (ok && flushNextRun(cache))
+    return;
+
+  finishFlush(cache, ok);
+}
+/*----------------------------------------------------------------------------*/
+static void onPendingEvent(void *argument)
+{
+  struct CodecCache * const cache = argument;
+
+  cache->scheduled = false;
+
+  if (cache->blocking || !isDirty(cache))
+    return;
+
+  /*
+   * Flush is started again when the transfer of the codec driver is
+   * finished or when the bus is released.
+   */
+  if (cache->state != STATE_IDLE
+      || ifSetParam(cache->bus, IF_ACQUIRE, NULL) != E_OK)
+  {
+    return;
+  }
+
+  cache->owned = true;
+  ifSetParam(cache->bus, IF_ADDRESS, &cache->codec);
+  ifSetParam(cache->bus, IF_ZEROCOPY, NULL);
+
+  if (!flushNextRun(cache))
+    finishFlush(cache, false);
+}
+/*----------------------------------------------------------------------------*/
+static void onVerifyEvent(struct CodecCache *cache)
+{
+  bool ok = ifGetParam(cache->bus, IF_STATUS, NULL) == E_OK;
+
+  if (ok)
+  {
+    switch ((enum State)cache->state)
+    {
+      case STATE_VERIFY_PAGE:
+        storeReg(cache, REG_PAGE_SELECT, cache->trimmed[1]);
+
+        if (startWindowRead(cache))
+          return;
+        ok = false;
+        break;
+
+      case STATE_VERIFY_POINTER:
+        cache->state = STATE_VERIFY_READ;
+
+        if (ifRead(cache->bus, cache->window, cache->span))
+          return;
+        ok = false;
+        break;
+
+      case STATE_VERIFY_READ:
+        if (resyncWindow(cache))
+          return;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  finishVerification(cache, ok);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cacheInit(void *object, const void *arguments)
+{
+  const struct CodecCacheConfig * const config = arguments;
+  struct CodecCache * const cache = object;
+
+  cache->callback = NULL;
+  cache->bus = config->bus;
+  cache->wq = config->wq != NULL ? config->wq : WQ_DEFAULT;
+  cache->codec = config->address;
+  cache->address = 0;
+  cache->status = E_OK;
+  cache->cursor = 0;
+  cache->sweep = 0;
+  cache->pointer = 0;
+  cache->deferred = false;
+  cache->repeated = false;
+  cache->blocking = true;
+  cache->resync = false;
+  cache->scheduled = false;
+  cache->postponed = false;
+  cache->owned = false;
+  cache->state = STATE_IDLE;
+
+  codecCacheInvalidate(cache);
+  ifSetCallback(cache->bus, onBusEvent, cache);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void cacheSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct CodecCache * const cache = object;
+
+  cache->argument = argument;
+  cache->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cacheGetParam(void *object, int parameter, void *data)
+{
+  struct CodecCache * const cache = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_STATUS:
+      if (cache->state == STATE_PASSTHROUGH)
+        return ifGetParam(cache->bus, IF_STATUS, NULL);
+      return cache->state != STATE_IDLE ? E_BUSY : cache->status;
+
+    default:
+      return ifGetParam(cache->bus, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cacheSetParam(void *object, int parameter, const void *data)
+{
+  struct CodecCache * const cache = object;
+
+  if (parameter == IF_I2C_REPEATED_START && cache->address == cache->codec)
+  {
+    /* Register pointer write may be served without a bus transfer */
+    cache->repeated = true;
+    return E_OK;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_ADDRESS:
+      cache->address = *(const uint32_t *)data;
+      break;
+
+    case IF_BLOCKING:
+      cache->blocking = true;
+      break;
+
+    case IF_ZEROCOPY:
+      cache->blocking = false;
+      break;
+
+    default:
+      break;
+  }
+
+  const enum Result res = ifSetParam(cache->bus, parameter, data);
+
+  /* Pending writes are completed before switching to blocking mode */
+  if (parameter == IF_BLOCKING && res == E_OK && cache->state == STATE_IDLE)
+    flushBlocking(cache);
+
+  if (parameter == IF_RELEASE)
+    resumeFlush(cache);
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static size_t cacheRead(void *object, void *buffer, size_t length)
+{
+  struct CodecCache * const cache = object;
+  const bool deferred = cache->deferred;
+
+  cache->deferred = false;
+
+  if (cache->address != cache->codec || !deferred || !length)
+  {
+    cache->state = STATE_PASSTHROUGH;
+    return ifRead(cache->bus, buffer, length);
+  }
+
+  bool hit = cache->pointer + length <= CODEC_CACHE_REGS;
+
+  for (size_t i = 0; i < length && hit; ++i)
+    hit = isRegValid(cache, (uint8_t)(cache->pointer + i));
+
+  cache->rxBuffer = buffer;
+  cache->rxLength = length;
+
+  if (hit)
+  {
+    memcpy(buffer, &cache->image[cache->page][cache->pointer], length);
+
+    if (complete(cache))
+      return length;
+  }
+
+  return readFromBus(cache);
+}
+/*----------------------------------------------------------------------------*/
+static size_t cacheWrite(void *object, const void *buffer, size_t length)
+{
+  struct CodecCache * const cache = object;
+  const uint8_t * const data = buffer;
+  const bool repeated = cache->repeated;
+
+  cache->deferred = false;
+  cache->repeated = false;
+
+  if (cache->address == cache->codec && length == 1 && repeated)
+  {
+    /* Register pointer is sent together with the following read */
+    cache->pointer = data[0];
+    cache->deferred = true;
+
+    if (complete(cache))
+      return length;
+
+    cache->deferred = false;
+    ifSetParam(cache->bus, IF_I2C_REPEATED_START, NULL);
+    return writeToBus(cache, data, length);
+  }
+
+  if (cache->address != cache->codec || length < 2)
+  {
+    if (repeated)
+      ifSetParam(cache->bus, IF_I2C_REPEATED_START, NULL);
+
+    cache->state = STATE_PASSTHROUGH;
+    return ifWrite(cache->bus, buffer, length);
+  }
+
+  if (!cache->blocking)
+  {
+    if (absorbWrite(cache, data, length))
+    {
+      if (complete(cache))
+        return length;
+    }
+    else if (isDirty(cache))
+      return postponeWrite(cache, data, length);
+  }
+
+  const uint8_t reg = data[0];
+  size_t first = length;
+  size_t last = 0;
+
+  if (reg == REG_PAGE_SELECT)
+  {
+    if (length != 2 || data[1] != cache->page)
+    {
+      first = 1;
+      last = length - 1;
+    }
+  }
+  else
+  {
+    for (size_t i = 1; i < length; ++i)
+    {
+      const uint8_t current = (uint8_t)(reg + i - 1);
+
+      if (!isRegValid(cache, current)
+          || cache->image[cache->page][current] != data[i])
+      {
+        if (first == length)
+          first = i;
+        last = i;
+      }
+    }
+  }
+
+  if (first > last)
+  {
+    /* Codec already holds the requested values */
+    if (complete(cache))
+      return length;
+
+    first = 1;
+    last = length - 1;
+  }
+
+  const size_t span = last - first + 1;
+
+  if (span < length - 1 && span <= CONFIG_CODEC_CACHE_BURST)
+  {
+    /* Send only the registers that change */
+    cache->trimmed[0] = (uint8_t)(reg + first - 1);
+    memcpy(cache->trimmed + 1, data + first, span);
+
+    return writeToBus(cache, cache->trimmed, span + 1) == span + 1 ?
+        length : 0;
+  }
+  else
+    return writeToBus(cache, data, length);
+}
+/*----------------------------------------------------------------------------*/
+void codecCacheInvalidate(struct CodecCache *cache)
+{
+  memset(cache->dirty, 0, sizeof(cache->dirty));
+  memset(cache->valid, 0, sizeof(cache->valid));
+  cache->page = CODEC_CACHE_PAGES;
+  cache->stale = false;
+}
+/*----------------------------------------------------------------------------*/
+bool codecCacheResync(struct CodecCache *cache)
+{
+  markStale(cache);
+  return codecCacheVerify(cache);
+}
+/*----------------------------------------------------------------------------*/
+bool codecCacheVerify(struct CodecCache *cache)
+{
+  if (cache->blocking || cache->deferred || cache->state != STATE_IDLE)
+    return false;
+
+  /* Image differs from the codec until the pending writes are flushed */
+  if (isDirty(cache))
+  {
+    scheduleFlush(cache);
+    return false;
+  }
+
+  if (ifSetParam(cache->bus, IF_ACQUIRE, NULL) != E_OK)
+    return false;
+
+  if (cache->stale)
+  {
+    /* All known registers are checked before the image is trusted again */
+    cache->resync = true;
+    cache->sweep = IMAGE_SIZE;
+  }
+
+  if (!findWindow(cache))
+  {
+    /* Nothing to compare, the image is empty */
+    cache->resync = false;
+    cache->stale = false;
+
+    ifSetParam(cache->bus, IF_RELEASE, NULL);
+    return false;
+  }
+
+  ifSetParam(cache->bus, IF_ADDRESS, &cache->codec);
+  ifSetParam(cache->bus, IF_ZEROCOPY, NULL);
+
+  if (!startVerification(cache))
+  {
+    finishVerification(cache, false);
+    return false;
+  }
+
+  return true;
+}
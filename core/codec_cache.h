@@ -0,0 +1,130 @@
+/*
+ * core/codec_cache.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_CODEC_CACHE_H_
+#define CORE_CODEC_CACHE_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/interface.h>
+/*----------------------------------------------------------------------------*/
+#ifndef CONFIG_CODEC_CACHE_BURST
+#  define CONFIG_CODEC_CACHE_BURST 8
+#endif
+
+/* Maximum number of registers read back during one verification step */
+#ifndef CONFIG_CODEC_CACHE_WINDOW
+#  define CONFIG_CODEC_CACHE_WINDOW 8
+#endif
+
+#define CODEC_CACHE_PAGES         2
+#define CODEC_CACHE_REGS          128
+
+/*
+ * Register writes in non-blocking mode are collected in the image and
+ * flushed as bursts of adjacent registers when the bus becomes free.
+ */
+extern const struct InterfaceClass * const CodecCache;
+
+struct WorkQueue;
+
+struct CodecCacheConfig
+{
+  /** Mandatory: underlying I2C interface. */
+  struct Interface *bus;
+  /** Optional: work queue for completion of transfers served from cache. */
+  struct WorkQueue *wq;
+  /** Mandatory: address of the codec. */
+  uint32_t address;
+};
+
+struct CodecCache
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  struct Interface *bus;
+  struct WorkQueue *wq;
+
+  /* Register images of both pages */
+  uint8_t image[CODEC_CACHE_PAGES][CODEC_CACHE_REGS];
+  /* Bit mask of the registers with known values */
+  uint32_t valid[CODEC_CACHE_PAGES * CODEC_CACHE_REGS / 32];
+  /* Bit mask of the registers written to the image but not to the codec */
+  uint32_t dirty[CODEC_CACHE_PAGES * CODEC_CACHE_REGS / 32];
+
+  /* Buffer for writes trimmed to the changed registers */
+  uint8_t trimmed[CONFIG_CODEC_CACHE_BURST + 1];
+  /* Register values read back during verification */
+  uint8_t window[CONFIG_CODEC_CACHE_WINDOW];
+
+  /* Data of the transfer in progress */
+  const uint8_t *txBuffer;
+  uint8_t *rxBuffer;
+  size_t txLength;
+  size_t rxLength;
+
+  /* Address of the codec */
+  uint32_t codec;
+  /* Current address on the bus */
+  uint32_t address;
+  /* Status of the last transfer */
+  enum Result status;
+
+  /* Position of the next verification window in the register image */
+  uint16_t cursor;
+  /* Image positions left to check during the resynchronization */
+  uint16_t sweep;
+  /* First register and length of the current verification window */
+  uint8_t origin;
+  uint8_t span;
+
+  /* Current register page or CODEC_CACHE_PAGES when unknown */
+  uint8_t page;
+  /* Register pointer of the following read */
+  uint8_t pointer;
+  /* Register pointer was set without a bus transfer */
+  bool deferred;
+  /* Repeated start was requested for the next write */
+  bool repeated;
+  /* Transfers complete before returning */
+  bool blocking;
+  /* Codec registers may differ from the image after a bus error */
+  bool stale;
+  /* All known registers are being checked */
+  bool resync;
+  /* Flush of pending register writes is in the work queue */
+  bool scheduled;
+  /* Write is postponed until pending register writes are flushed */
+  bool postponed;
+  /* Bus was acquired for the flush */
+  bool owned;
+  /* Current state of the transfer */
+  uint8_t state;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void codecCacheInvalidate(struct CodecCache *);
+
+/*
+ * Check all known registers after a bus error and rewrite the registers
+ * that differ from the image. Cached values are not used until the check
+ * is finished, it is continued by the following verification calls when
+ * the interface is busy.
+ */
+bool codecCacheResync(struct CodecCache *);
+
+/*
+ * Read back the next window of known registers in the background and
+ * rewrite the registers that differ from the image. Returns false when
+ * the interface is busy or no register values are known.
+ */
+bool codecCacheVerify(struct CodecCache *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_CODEC_CACHE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * memory_monitor.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "memory_monitor.h"
+#include <errno.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_CORE_CORTEX_MEMORY_PATTERN
+#  define MEMORY_PATTERN  CONFIG_CORE_CORTEX_MEMORY_PATTERN
+#else
+#  define MEMORY_PATTERN  0xDEADBEEF
+#endif
+
+/* Memory below the current stack pointer reserved for interrupts */
+#define STACK_GUARD       64
+/*----------------------------------------------------------------------------*/
+/* Symbols are defined in the linker script */
+[[gnu::weak]] extern uint32_t heap_start[];
+[[gnu::weak]] extern uint32_t _stack[];
+/*----------------------------------------------------------------------------*/
+void *_sbrk(ptrdiff_t);
+/*----------------------------------------------------------------------------*/
+static struct
+{
+  /* Current and highest program break */
+  uint8_t *position;
+  uint8_t *peak;
+} heap = {
+    .position = NULL,
+    .peak = NULL
+};
+/*----------------------------------------------------------------------------*/
+void *_sbrk(ptrdiff_t increment)
+{
+  uint8_t * const stack = __builtin_frame_address(0);
+
+  if (heap.position == NULL)
+  {
+    heap.position = (uint8_t *)heap_start;
+    heap.peak = heap.position;
+  }
+
+  /* Heap is not allowed to grow into the stack in use */
+  if (heap.position + increment > stack - STACK_GUARD)
+  {
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+
+  uint8_t * const previous = heap.position;
+
+  heap.position += increment;
+  if (heap.position > heap.peak)
+    heap.peak = heap.position;
+
+  return previous;
+}
+/*----------------------------------------------------------------------------*/
+void memoryMonitorGetUsage(struct MemoryUsage *usage)
+{
+  usage->heap = 0;
+  usage->stack = 0;
+  usage->free = 0;
+
+  if (heap_start == NULL || _stack == NULL)
+    return;
+
+  const uint32_t *position = heap.peak != NULL ?
+      (const uint32_t *)(((uintptr_t)heap.peak + 3) & ~(uintptr_t)3) :
+      heap_start;
+
+  /* Memory is scanned from the heap end to the deepest stack frame */
+  while (position < _stack && *position == MEMORY_PATTERN)
+    ++position;
+
+  usage->heap = heap.peak != NULL ?
+      (size_t)(heap.peak - (const uint8_t *)heap_start) : 0;
+  usage->stack = (size_t)((const uint8_t *)_stack
+      - (const uint8_t *)position);
+  usage->free = (size_t)((const uint8_t *)position
+      - (const uint8_t *)heap_start) - usage->heap;
+}
+/*----------------------------------------------------------------------------*/
+void memoryMonitorInit(void)
+{
+  if (heap_start == NULL || _stack == NULL)
+    return;
+
+  uint32_t * const end =
+      (uint32_t *)((uintptr_t)__builtin_frame_address(0) - STACK_GUARD);
+  uint32_t *position = heap.peak != NULL ?
+      (uint32_t *)(((uintptr_t)heap.peak + 3) & ~(uintptr_t)3) : heap_start;
+
+  while (position < end)
+    *position++ = MEMORY_PATTERN;
+}
@@ -0,0 +1,33 @@
+/*
+ * core/memory_monitor.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_MEMORY_MONITOR_H_
+#define CORE_MEMORY_MONITOR_H_
+/*----------------------------------------------------------------------------*/
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+struct MemoryUsage
+{
+  /* Peak size of the heap */
+  size_t heap;
+  /* Peak depth of the stack */
+  size_t stack;
+  /* Memory between the heap and the stack never used by either of them */
+  size_t free;
+};
+/*----------------------------------------------------------------------------*/
+/*
+ * Fill the unused memory between the heap and the stack with a pattern.
+ * Should be called at the beginning of the main function before any
+ * allocations. Usage is reported as zero when memory layout symbols are
+ * not provided by the linker script.
+ */
+void memoryMonitorInit(void);
+
+/* Heap usage is tracked by the allocator, stack usage is found by a scan */
+void memoryMonitorGetUsage(struct MemoryUsage *);
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_MEMORY_MONITOR_H_ */
@@ -0,0 +1,221 @@
+/*
+ * profile.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "profile.h"
+#include <halm/irq.h>
+#include <halm/timer.h>
+#include <xcore/interface.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+/* Prefix, task identifier, hexadecimal counters and line ending */
+#define DUMP_LINE_LENGTH \
+    (2 + 2 + sizeof(struct ProfileHistogram) * 2 + 2)
+
+static_assert(CONFIG_PROFILE_TASKS <= 32, "Too many tasks");
+/*----------------------------------------------------------------------------*/
+static void dumpHistogram(struct Interface *, char, uint8_t,
+    const struct ProfileHistogram *);
+static uint32_t getInterval(uint32_t, uint32_t);
+static bool isHistogramEmpty(const struct ProfileHistogram *);
+static size_t printHex(char *, const uint8_t *, size_t);
+static void updateHistogram(struct ProfileHistogram *, uint32_t);
+/*----------------------------------------------------------------------------*/
+static struct
+{
+  struct Timer *timer;
+  /* Period of the timestamp timer */
+  uint32_t period;
+
+  struct ProfileHistogram run[CONFIG_PROFILE_TASKS];
+  struct ProfileHistogram wait[CONFIG_PROFILE_TASKS];
+
+  /* Timestamps of the task start and of the task submission */
+  uint32_t entered[CONFIG_PROFILE_TASKS];
+  uint32_t queued[CONFIG_PROFILE_TASKS];
+  /* Bit mask of the submitted tasks waiting for execution */
+  uint32_t pending;
+  /* Bit mask of the tasks being executed */
+  uint32_t running;
+  /* Next histogram to be dumped, run and wait histograms are interleaved */
+  uint8_t cursor;
+} profile = {
+    .timer = NULL
+};
+/*----------------------------------------------------------------------------*/
+static void dumpHistogram(struct Interface *serial, char prefix, uint8_t task,
+    const struct ProfileHistogram *histogram)
+{
+  char text[DUMP_LINE_LENGTH];
+  struct ProfileHistogram buffer;
+  size_t length = 0;
+
+  const IrqState state = irqSave();
+  buffer = *histogram;
+  irqRestore(state);
+
+  text[length++] = prefix;
+  text[length++] = ':';
+  length += printHex(text + length, &task, sizeof(task));
+  length += printHex(text + length, (const uint8_t *)&buffer, sizeof(buffer));
+  text[length++] = '\r';
+  text[length++] = '\n';
+  ifWrite(serial, text, length);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getInterval(uint32_t start, uint32_t end)
+{
+  /* Intervals are shorter than one period of the timestamp timer */
+  return end >= start ? end - start : end + profile.period - start;
+}
+/*----------------------------------------------------------------------------*/
+static bool isHistogramEmpty(const struct ProfileHistogram *histogram)
+{
+  for (size_t index = 0; index < CONFIG_PROFILE_BUCKETS; ++index)
+  {
+    if (histogram->buckets[index])
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t printHex(char *text, const uint8_t *data, size_t length)
+{
+  static const char symbols[] = "0123456789ABCDEF";
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    *text++ = symbols[data[i] >> 4];
+    *text++ = symbols[data[i] & 0x0F];
+  }
+
+  return length * 2;
+}
+/*----------------------------------------------------------------------------*/
+static void updateHistogram(struct ProfileHistogram *histogram,
+    uint32_t interval)
+{
+  size_t index = 0;
+
+  /* Integer logarithm without a count leading zeros instruction */
+  while (interval > 1 && index < CONFIG_PROFILE_BUCKETS - 1)
+  {
+    interval >>= 1;
+    ++index;
+  }
+
+  if (histogram->buckets[index] < UINT16_MAX)
+    ++histogram->buckets[index];
+}
+/*----------------------------------------------------------------------------*/
+void profileDump(struct Interface *serial)
+{
+  /* Dump is continued from the same histogram when the buffer is full */
+  for (size_t count = 0; count < CONFIG_PROFILE_TASKS * 2; ++count)
+  {
+    const uint8_t task = profile.cursor >> 1;
+    const bool wait = (profile.cursor & 1) != 0;
+    const struct ProfileHistogram * const histogram = wait ?
+        &profile.wait[task] : &profile.run[task];
+
+    if (!isHistogramEmpty(histogram))
+    {
+      size_t available;
+
+      if (ifGetParam(serial, IF_TX_AVAILABLE, &available) != E_OK)
+        return;
+      if (available < DUMP_LINE_LENGTH)
+        return;
+
+      dumpHistogram(serial, wait ? 'W' : 'R', task, histogram);
+    }
+
+    profile.cursor = (profile.cursor + 1) % (CONFIG_PROFILE_TASKS * 2);
+  }
+}
+/*----------------------------------------------------------------------------*/
+void profileEnter(uint8_t task)
+{
+  if (profile.timer == NULL)
+    return;
+
+  assert(task < CONFIG_PROFILE_TASKS);
+
+  const uint32_t timestamp = timerGetValue(profile.timer);
+  const IrqState state = irqSave();
+
+  /* Tasks called directly from other tasks have no wait time */
+  if (profile.pending & (1UL << task))
+  {
+    profile.pending &= ~(1UL << task);
+    updateHistogram(&profile.wait[task],
+        getInterval(profile.queued[task], timestamp));
+  }
+
+  profile.running |= 1UL << task;
+  profile.entered[task] = timestamp;
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+void profileExit(uint8_t task)
+{
+  if (profile.timer == NULL)
+    return;
+
+  assert(task < CONFIG_PROFILE_TASKS);
+
+  const uint32_t timestamp = timerGetValue(profile.timer);
+  const IrqState state = irqSave();
+
+  /* Tasks started before the initialization are skipped */
+  if (profile.running & (1UL << task))
+  {
+    profile.running &= ~(1UL << task);
+    updateHistogram(&profile.run[task],
+        getInterval(profile.entered[task], timestamp));
+  }
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+void profileInit(struct Timer *timer)
+{
+  for (size_t task = 0; task < CONFIG_PROFILE_TASKS; ++task)
+  {
+    for (size_t index = 0; index < CONFIG_PROFILE_BUCKETS; ++index)
+    {
+      profile.run[task].buckets[index] = 0;
+      profile.wait[task].buckets[index] = 0;
+    }
+  }
+
+  profile.pending = 0;
+  profile.running = 0;
+  profile.cursor = 0;
+  profile.period = timerGetOverflow(timer);
+  profile.timer = timer;
+}
+/*----------------------------------------------------------------------------*/
+void profileQueue(uint8_t task)
+{
+  if (profile.timer == NULL)
+    return;
+
+  assert(task < CONFIG_PROFILE_TASKS);
+
+  const uint32_t timestamp = timerGetValue(profile.timer);
+  const IrqState state = irqSave();
+
+  /* Wait time is measured from the first submission */
+  if (!(profile.pending & (1UL << task)))
+  {
+    profile.pending |= 1UL << task;
+    profile.queued[task] = timestamp;
+  }
+
+  irqRestore(state);
+}
@@ -0,0 +1,52 @@
+/*
+ * core/profile.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_PROFILE_H_
+#define CORE_PROFILE_H_
+/*----------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Histogram buckets, bucket N counts intervals from 2^N to 2^(N+1) - 1 */
+#ifndef CONFIG_PROFILE_BUCKETS
+#  define CONFIG_PROFILE_BUCKETS 12
+#endif
+
+/* Number of task identifiers starting from zero */
+#ifndef CONFIG_PROFILE_TASKS
+#  define CONFIG_PROFILE_TASKS 16
+#endif
+
+struct Interface;
+struct Timer;
+
+struct ProfileHistogram
+{
+  uint16_t buckets[CONFIG_PROFILE_BUCKETS];
+};
+/*----------------------------------------------------------------------------*/
+/*
+ * Histograms are dumped as text lines: "R:" prefix for run times or "W:"
+ * prefix for queue wait times followed by a task identifier and saturated
+ * 16-bit bucket counters in hexadecimal form.
+ */
+void profileDump(struct Interface *);
+void profileEnter(uint8_t);
+void profileExit(uint8_t);
+void profileInit(struct Timer *);
+void profileQueue(uint8_t);
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_PROFILE
+#  define PROFILE_ENTER(task)  profileEnter(task)
+#  define PROFILE_EXIT(task)   profileExit(task)
+#  define PROFILE_QUEUE(task)  profileQueue(task)
+#else
+#  define PROFILE_ENTER(task)  do {} while (0)
+#  define PROFILE_EXIT(task)   do {} while (0)
+#  define PROFILE_QUEUE(task)  do {} while (0)
+#endif
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_PROFILE_H_ */
@@ -8,48 +8,300 @@
 #include <halm/generic/flash.h>
 #include <xcore/crc/crc8_dallas.h>
 #include <xcore/interface.h>
+#include <assert.h>
 #include <string.h>
 /*----------------------------------------------------------------------------*/
-#define MAGIC_NUMBER 0x61
-#define PAGE_SIZE    256
+#define MAGIC_NUMBER  0x61
+#define RECORD_MAGIC  0x63
+#define PAGE_SIZE     256
+#define SECTOR_SIZE   4096
+#define RECORD_COUNT  (SECTOR_SIZE / PAGE_SIZE)
+
+enum
+{
+  STATE_IDLE,
+  STATE_ERASE,
+  STATE_PROGRAM,
+  STATE_VERIFY
+};
+
+static_assert(CONFIG_PRESET_COUNT <= 8, "Too many presets");
 /*----------------------------------------------------------------------------*/
-bool loadSettings(struct Interface *memory, uint32_t address,
+static bool findNewestRecord(struct Interface *, uint32_t,
+    struct SettingsRecord *, size_t *);
+static bool isRecordBlank(const struct SettingsRecord *);
+static bool readLegacySettings(struct Interface *, uint32_t,
+    struct Settings *);
+static bool readRecord(struct Interface *, uint32_t, struct SettingsRecord *);
+static void reloadRecord(struct SettingsWriter *);
+static void startWrite(struct SettingsWriter *);
+static bool validateSettings(const struct Settings *);
+/*----------------------------------------------------------------------------*/
+static bool findNewestRecord(struct Interface *memory, uint32_t address,
+    struct SettingsRecord *newest, size_t *index)
+{
+  bool found = false;
+
+  for (size_t i = 0; i < RECORD_COUNT; ++i)
+  {
+    struct SettingsRecord record;
+
+    if (!readRecord(memory, address + i * PAGE_SIZE, &record))
+    {
+      /* Records are appended in order, the rest of the sector is empty */
+      if (isRecordBlank(&record))
+        break;
+      else
+        continue;
+    }
+
+    if (!found || (int16_t)(record.sequence - newest->sequence) > 0)
+    {
+      *newest = record;
+      *index = i;
+      found = true;
+    }
+  }
+
+  return found;
+}
+/*----------------------------------------------------------------------------*/
+static bool isRecordBlank(const struct SettingsRecord *record)
+{
+  const uint8_t * const data = (const uint8_t *)record;
+
+  for (size_t i = 0; i < sizeof(struct SettingsRecord); ++i)
+  {
+    if (data[i] != 0xFF)
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool readLegacySettings(struct Interface *memory, uint32_t address,
     struct Settings *settings)
 {
-  uint8_t buffer[sizeof(struct Settings)];
+  struct Settings buffer;
+
+  if (ifSetParam(memory, IF_POSITION, &address) != E_OK)
+    return false;
+  if (ifRead(memory, &buffer, sizeof(buffer)) != sizeof(buffer))
+    return false;
+  if (!validateSettings(&buffer))
+    return false;
+
+  *settings = buffer;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool readRecord(struct Interface *memory, uint32_t address,
+    struct SettingsRecord *record)
+{
+  memset(record, 0xFF, sizeof(*record));
 
   if (ifSetParam(memory, IF_POSITION, &address) != E_OK)
     return false;
-  if (ifRead(memory, buffer, sizeof(buffer)) != sizeof(buffer))
+  if (ifRead(memory, record, sizeof(*record)) != sizeof(*record))
+    return false;
+  if (record->magic != RECORD_MAGIC)
     return false;
-  if (buffer[0] != MAGIC_NUMBER)
+
+  const uint8_t checksum = crc8DallasUpdate(0, record, sizeof(*record) - 1);
+
+  return record->checksum == checksum;
+}
+/*----------------------------------------------------------------------------*/
+static void reloadRecord(struct SettingsWriter *writer)
+{
+  size_t index;
+
+  if (!findNewestRecord(writer->memory, writer->sector, &writer->record,
+      &index))
+  {
+    memset(&writer->record, 0, sizeof(writer->record));
+    writer->record.sequence = UINT16_MAX;
+
+    /* Settings saved by previous firmware versions in a single page */
+    readLegacySettings(writer->memory, writer->sector,
+        &writer->record.settings);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void startWrite(struct SettingsWriter *writer)
+{
+  struct SettingsRecord * const record = &writer->record;
+  struct SettingsRecord newest;
+  size_t index = 0;
+
+  if (findNewestRecord(writer->memory, writer->sector, &newest, &index))
+    ++index;
+
+  record->magic = RECORD_MAGIC;
+  ++record->sequence;
+  record->checksum = crc8DallasUpdate(0, record, sizeof(*record) - 1);
+
+  writer->address = writer->sector;
+  writer->state = STATE_ERASE;
+
+  if (index < RECORD_COUNT)
+  {
+    struct SettingsRecord next;
+
+    /* Append a record when the following page is still erased */
+    readRecord(writer->memory, writer->sector + index * PAGE_SIZE, &next);
+
+    if (isRecordBlank(&next))
+    {
+      writer->address += index * PAGE_SIZE;
+      writer->state = STATE_PROGRAM;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool validateSettings(const struct Settings *settings)
+{
+  if (settings->magic != MAGIC_NUMBER)
     return false;
 
-  const uint8_t checksum = crc8DallasUpdate(0, buffer, sizeof(buffer) - 1);
+  const uint8_t checksum = crc8DallasUpdate(0, settings,
+      sizeof(struct Settings) - 1);
 
-  if (buffer[sizeof(buffer) - 1] == checksum)
+  return settings->checksum == checksum;
+}
+/*----------------------------------------------------------------------------*/
+bool loadSettings(struct Interface *memory, uint32_t address,
+    struct Settings *settings)
+{
+  struct SettingsRecord record;
+  size_t index;
+
+  if (findNewestRecord(memory, address, &record, &index))
   {
-    memcpy(settings, buffer, sizeof(buffer));
+    if (!validateSettings(&record.settings))
+      return false;
+
+    *settings = record.settings;
     return true;
   }
-  else
+
+  /* Settings saved by previous firmware versions in a single page */
+  return readLegacySettings(memory, address, settings);
+}
+/*----------------------------------------------------------------------------*/
+void settingsWriterInit(struct SettingsWriter *writer,
+    struct Interface *memory, uint32_t sector)
+{
+  writer->memory = memory;
+  writer->sector = sector;
+  writer->address = sector;
+  writer->state = STATE_IDLE;
+
+  reloadRecord(writer);
+}
+/*----------------------------------------------------------------------------*/
+bool settingsWriterGetPreset(const struct SettingsWriter *writer,
+    size_t index, struct Preset *preset)
+{
+  if (index >= CONFIG_PRESET_COUNT || !(writer->record.used & (1 << index)))
+    return false;
+
+  *preset = writer->record.presets[index];
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+bool settingsWriterSavePreset(struct SettingsWriter *writer, size_t index,
+    const struct Preset *preset)
+{
+  struct SettingsRecord * const record = &writer->record;
+
+  assert(writer->state == STATE_IDLE);
+  assert(index < CONFIG_PRESET_COUNT);
+
+  /* Stored preset is already up to date */
+  if ((record->used & (1 << index))
+      && !memcmp(&record->presets[index], preset, sizeof(*preset)))
+  {
     return false;
+  }
+
+  record->used |= 1 << index;
+  record->presets[index] = *preset;
+
+  startWrite(writer);
+  return true;
 }
 /*----------------------------------------------------------------------------*/
-void saveSettings(struct Interface *memory, uint32_t address,
+bool settingsWriterSaveSettings(struct SettingsWriter *writer,
     const struct Settings *settings)
 {
-  uint8_t buffer[PAGE_SIZE];
+  struct SettingsRecord * const record = &writer->record;
+  struct Settings buffer = *settings;
 
-  memset(buffer, 0xFF, sizeof(buffer));
-  memcpy(buffer, settings, sizeof(struct Settings));
-  buffer[0] = MAGIC_NUMBER;
-  buffer[sizeof(struct Settings) - 1] =
-      crc8DallasUpdate(0, buffer, sizeof(struct Settings) - 1);
+  assert(writer->state == STATE_IDLE);
 
-  if (ifSetParam(memory, IF_FLASH_ERASE_SECTOR, &address) != E_OK)
-    return;
-  if (ifSetParam(memory, IF_POSITION, &address) != E_OK)
-    return;
-  ifWrite(memory, buffer, sizeof(buffer));
+  buffer.magic = MAGIC_NUMBER;
+  buffer.checksum = crc8DallasUpdate(0, &buffer, sizeof(buffer) - 1);
+
+  /* Stored settings are already up to date */
+  if (!memcmp(&record->settings, &buffer, sizeof(buffer)))
+    return false;
+
+  record->settings = buffer;
+  startWrite(writer);
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+enum Result settingsWriterStep(struct SettingsWriter *writer)
+{
+  switch (writer->state)
+  {
+    case STATE_ERASE:
+      if (ifSetParam(writer->memory, IF_FLASH_ERASE_SECTOR,
+          &writer->sector) != E_OK)
+      {
+        break;
+      }
+
+      writer->state = STATE_PROGRAM;
+      return E_BUSY;
+
+    case STATE_PROGRAM:
+    {
+      uint8_t buffer[PAGE_SIZE];
+
+      memset(buffer, 0xFF, sizeof(buffer));
+      memcpy(buffer, &writer->record, sizeof(writer->record));
+
+      if (ifSetParam(writer->memory, IF_POSITION, &writer->address) != E_OK)
+        break;
+      if (ifWrite(writer->memory, buffer, sizeof(buffer)) != sizeof(buffer))
+        break;
+
+      writer->state = STATE_VERIFY;
+      return E_BUSY;
+    }
+
+    case STATE_VERIFY:
+    {
+      struct SettingsRecord record;
+
+      if (!readRecord(writer->memory, writer->address, &record))
+        break;
+      if (memcmp(&record, &writer->record, sizeof(record)))
+        break;
+
+      writer->state = STATE_IDLE;
+      return E_OK;
+    }
+
+    default:
+      return E_IDLE;
+  }
+
+  /* Keep the content of the flash memory after a failure */
+  writer->state = STATE_IDLE;
+  reloadRecord(writer);
+
+  return E_ERROR;
 }
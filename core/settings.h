@@ -7,8 +7,14 @@
 #ifndef CORE_SETTINGS_H_
 #define CORE_SETTINGS_H_
 /*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <stddef.h>
 #include <stdint.h>
 /*----------------------------------------------------------------------------*/
+#ifndef CONFIG_PRESET_COUNT
+#  define CONFIG_PRESET_COUNT 4
+#endif
+
 struct Interface;
 
 struct [[gnu::packed]] Settings
@@ -25,8 +31,59 @@ struct [[gnu::packed]] Settings
 
   uint8_t checksum;
 };
+
+/* Scene in the format of the slave registers */
+struct [[gnu::packed]] Preset
+{
+  uint8_t ctl;
+  uint8_t path;
+  uint8_t mic;
+  uint8_t spk;
+};
+
+/* Each record occupies a separate flash page in the settings sector */
+struct [[gnu::packed]] SettingsRecord
+{
+  uint8_t magic;
+  uint16_t sequence;
+  struct Settings settings;
+
+  /* Bit mask of the stored presets */
+  uint8_t used;
+  struct Preset presets[CONFIG_PRESET_COUNT];
+
+  uint8_t checksum;
+};
+
+struct SettingsWriter
+{
+  struct Interface *memory;
+  /* Address of the settings sector */
+  uint32_t sector;
+  /* Address of the page for the new record */
+  uint32_t address;
+  /* Content of the newest record */
+  struct SettingsRecord record;
+  /* Next step of the write sequence */
+  uint8_t state;
+};
 /*----------------------------------------------------------------------------*/
 bool loadSettings(struct Interface *, uint32_t, struct Settings *);
-void saveSettings(struct Interface *, uint32_t, const struct Settings *);
+
+/*
+ * Records are written in separate steps: sector erase when no erased page
+ * is left, page program and read back. Save functions return false when
+ * the stored values are already up to date. Step returns E_BUSY while more
+ * steps remain and the final result after the last one.
+ */
+void settingsWriterInit(struct SettingsWriter *, struct Interface *,
+    uint32_t);
+bool settingsWriterGetPreset(const struct SettingsWriter *, size_t,
+    struct Preset *);
+bool settingsWriterSavePreset(struct SettingsWriter *, size_t,
+    const struct Preset *);
+bool settingsWriterSaveSettings(struct SettingsWriter *,
+    const struct Settings *);
+enum Result settingsWriterStep(struct SettingsWriter *);
 /*----------------------------------------------------------------------------*/
 #endif /* CORE_SETTINGS_H_ */
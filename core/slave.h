@@ -10,7 +10,23 @@
 #include <xcore/bits.h>
 /*----------------------------------------------------------------------------*/
 #define SLAVE_ADDRESS   0x15
-#define SLAVE_REG_COUNT 9
+/* Registers of the page 0 available regardless of the selected page */
+#define SLAVE_REG_COUNT 11
+/* Paged window of the extended register map: header and page contents */
+#define SLAVE_WINDOW_BASE 0x10
+#define SLAVE_WINDOW_SIZE (sizeof(struct SlaveWindowHeader) + SLAVE_PAGE_SIZE)
+#define SLAVE_PAGE_SIZE 16
+#define SLAVE_MAP_SIZE  (SLAVE_WINDOW_BASE + SLAVE_WINDOW_SIZE)
+
+/*
+ * Window is refreshed after the firmware handles the write to the PAGE
+ * register. A read of the window in the same transaction, for example after
+ * a repeated start, or right after the write returns the previous contents.
+ * The host should read the window in a separate transaction issued at least
+ * SLAVE_WINDOW_TURNAROUND microseconds after the PAGE write and repeat the
+ * read while the page in the header differs from the selected one.
+ */
+#define SLAVE_WINDOW_TURNAROUND 1000
 
 enum
 {
@@ -22,7 +38,19 @@ enum
   SLAVE_REG_SW      = 0x05,
   SLAVE_REG_PATH    = 0x06,
   SLAVE_REG_MIC     = 0x07,
-  SLAVE_REG_SPK     = 0x08
+  SLAVE_REG_SPK     = 0x08,
+  SLAVE_REG_PRESET  = 0x09,
+  SLAVE_REG_CAUSE   = 0x0A,
+  /* Page selection for the window, window is refreshed on each access */
+  SLAVE_REG_PAGE    = 0x0F
+};
+
+enum
+{
+  SLAVE_PAGE_NONE       = 0x00,
+  SLAVE_PAGE_TELEMETRY  = 0x01,
+  SLAVE_PAGE_VERSION    = 0x02,
+  SLAVE_PAGE_DIAGNOSTIC = 0x03
 };
 
 struct [[gnu::packed]] SlaveRegOverlay
@@ -44,6 +72,69 @@ struct [[gnu::packed]] SlaveRegOverlay
   uint8_t mic;
   /* SPK level from 0 to 255 */
   uint8_t spk;
+
+  /*
+   * Bits 0..2 - preset index
+   * Bit 5     - last preset operation failed
+   * Bit 6     - store CTL, PATH, MIC and SPK registers to the preset
+   * Bit 7     - load CTL, PATH, MIC and SPK registers from the preset
+   */
+  uint8_t preset;
+
+  /*
+   * Pending causes of the attention request, the host acknowledges
+   * causes by clearing the bits
+   */
+  uint8_t cause;
+};
+
+struct [[gnu::packed]] SlaveWindowHeader
+{
+  /* Page of the window contents, echo of the PAGE register */
+  uint8_t page;
+  /* Incremented each time the window contents change */
+  uint8_t sequence;
+};
+
+/* Window pages, multibyte values are little-endian */
+struct [[gnu::packed]] SlaveTelemetryPage
+{
+  /* Supply voltage in millivolts */
+  uint16_t voltage;
+  /* Time since startup in control ticks of 100 ms */
+  uint32_t uptime;
+  uint8_t status;
+  uint8_t sw;
+  uint8_t reserved[8];
+};
+
+struct [[gnu::packed]] SlaveVersionPage
+{
+  uint8_t hwMajor;
+  uint8_t hwMinor;
+  uint8_t swMajor;
+  uint8_t swMinor;
+  uint32_t revision;
+  uint32_t hash;
+  uint32_t timestamp;
+};
+
+struct [[gnu::packed]] SlaveDiagnosticPage
+{
+  /* Slave register updates handled */
+  uint32_t updates;
+  /* Settings and preset records written to flash */
+  uint16_t writes;
+  /* Failed flash operations */
+  uint16_t failures;
+  /* Tasks rejected by the work queue */
+  uint16_t rejected;
+  /* Maximum number of pending events */
+  uint8_t watermark;
+  uint8_t reserved;
+  /* Peak heap size and stack depth in bytes */
+  uint16_t heap;
+  uint16_t stack;
 };
 /*------------------Reset control register------------------------------------*/
 #define SLAVE_RESET_RESET               BIT(0)
@@ -51,8 +142,12 @@ struct [[gnu::packed]] SlaveRegOverlay
 #define SLAVE_SYS_EXT_CLOCK             BIT(0)
 #define SLAVE_SYS_SUSPEND               BIT(1)
 #define SLAVE_SYS_SUSPEND_AUTO          BIT(2)
+/* Set by the firmware when the last settings save failed */
+#define SLAVE_SYS_SAVE_ERROR            BIT(6)
+/* Cleared by the firmware when the settings save is finished */
 #define SLAVE_SYS_SAVE_CONFIG           BIT(7)
-#define SLAVE_SYS_MASK                  (BIT_FIELD(MASK(3), 0) | BIT(7))
+#define SLAVE_SYS_MASK \
+    (BIT_FIELD(MASK(3), 0) | BIT_FIELD(MASK(2), 6))
 /*------------------Amplifier control register--------------------------------*/
 #define SLAVE_CTL_POWER                 BIT(0)
 #define SLAVE_CTL_GAIN0                 BIT(1)
@@ -79,5 +174,21 @@ enum
 
 #define SLAVE_PATH_INPUT_AGC            BIT(4)
 #define SLAVE_PATH_MASK                 MASK(5)
+/*------------------Preset control register-----------------------------------*/
+#define SLAVE_PRESET_INDEX(value)       BIT_FIELD((value), 0)
+#define SLAVE_PRESET_INDEX_MASK         BIT_FIELD(MASK(3), 0)
+#define SLAVE_PRESET_INDEX_VALUE(reg) \
+    FIELD_VALUE((reg), SLAVE_PRESET_INDEX_MASK, 0)
+
+#define SLAVE_PRESET_ERROR              BIT(5)
+#define SLAVE_PRESET_STORE              BIT(6)
+#define SLAVE_PRESET_RECALL             BIT(7)
+#define SLAVE_PRESET_MASK \
+    (SLAVE_PRESET_INDEX_MASK | BIT_FIELD(MASK(3), 5))
+/*------------------Attention cause register----------------------------------*/
+#define SLAVE_CAUSE_STATUS              BIT(0)
+#define SLAVE_CAUSE_SW                  BIT(1)
+#define SLAVE_CAUSE_STORAGE             BIT(2)
+#define SLAVE_CAUSE_MASK                MASK(3)
 /*----------------------------------------------------------------------------*/
 #endif /* CORE_SLAVE_H_ */
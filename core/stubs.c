@@ -7,22 +7,12 @@
 #include <xcore/accel.h>
 #include <stdio.h>
 /*----------------------------------------------------------------------------*/
-struct _reent;
-/*----------------------------------------------------------------------------*/
 void __assert_func(const char *, int, const char *, const char *)
 {
   invokeDebugger();
   while (1);
 }
 /*----------------------------------------------------------------------------*/
-void __malloc_lock(struct _reent *)
-{
-}
-/*----------------------------------------------------------------------------*/
-void __malloc_unlock(struct _reent *)
-{
-}
-/*----------------------------------------------------------------------------*/
 int _close(int)
 {
   return -1;
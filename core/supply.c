@@ -0,0 +1,62 @@
+/*
+ * supply.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "supply.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+static_assert(CONFIG_SUPPLY_OVERSAMPLING > 0
+    && CONFIG_SUPPLY_OVERSAMPLING <= UINT8_MAX
+    && !(CONFIG_SUPPLY_OVERSAMPLING & (CONFIG_SUPPLY_OVERSAMPLING - 1)),
+    "Incorrect oversampling");
+/*----------------------------------------------------------------------------*/
+void supplyMonitorInit(struct SupplyMonitor *monitor, uint16_t threshold,
+    uint16_t hysteresis)
+{
+  assert(hysteresis / 2 < threshold);
+
+  monitor->accumulator = 0;
+  monitor->threshold = threshold;
+  monitor->hysteresis = hysteresis;
+  monitor->value = 0;
+  monitor->count = 0;
+  monitor->powered = false;
+}
+/*----------------------------------------------------------------------------*/
+bool supplyMonitorUpdate(struct SupplyMonitor *monitor, uint16_t sample)
+{
+  monitor->accumulator += sample;
+
+  if (++monitor->count < CONFIG_SUPPLY_OVERSAMPLING)
+    return false;
+
+  /* Power of two divisor is replaced with a shift */
+  monitor->value = (uint16_t)(monitor->accumulator
+      / CONFIG_SUPPLY_OVERSAMPLING);
+  monitor->accumulator = 0;
+  monitor->count = 0;
+
+  /* State is changed only when the value leaves the hysteresis band */
+  if (monitor->powered)
+  {
+    if (monitor->value < monitor->threshold - monitor->hysteresis / 2)
+      monitor->powered = false;
+  }
+  else
+  {
+    if (monitor->value >= monitor->threshold + monitor->hysteresis / 2)
+      monitor->powered = true;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+uint16_t supplyMonitorMargin(const struct SupplyMonitor *monitor)
+{
+  if (monitor->value >= monitor->threshold)
+    return monitor->value - monitor->threshold;
+  else
+    return monitor->threshold - monitor->value;
+}
@@ -0,0 +1,52 @@
+/*
+ * core/supply.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_SUPPLY_H_
+#define CORE_SUPPLY_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Number of samples averaged into one filtered value, power of two */
+#ifndef CONFIG_SUPPLY_OVERSAMPLING
+#  define CONFIG_SUPPLY_OVERSAMPLING 4
+#endif
+
+struct SupplyMonitor
+{
+  /* Sum of the samples of the current decimation period */
+  uint32_t accumulator;
+
+  /* Switching threshold and width of the hysteresis band */
+  uint16_t threshold;
+  uint16_t hysteresis;
+  /* Last filtered value */
+  uint16_t value;
+
+  /* Samples accumulated during the current decimation period */
+  uint8_t count;
+  /* Filtered value is above the threshold */
+  bool powered;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void supplyMonitorInit(struct SupplyMonitor *, uint16_t, uint16_t);
+
+/*
+ * Accumulate a sample, thresholds use the same units as samples. Returns
+ * true when the decimation period is finished and a new filtered value
+ * is available.
+ */
+bool supplyMonitorUpdate(struct SupplyMonitor *, uint16_t);
+
+/* Distance between the filtered value and the threshold */
+uint16_t supplyMonitorMargin(const struct SupplyMonitor *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_SUPPLY_H_ */
@@ -0,0 +1,142 @@
+/*
+ * trace.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "trace.h"
+#include <halm/irq.h>
+#include <halm/timer.h>
+#include <xcore/interface.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define DUMP_RECORDS_PER_LINE 8
+/* Prefix, hexadecimal records and line ending */
+#define DUMP_LINE_LENGTH \
+    (2 + DUMP_RECORDS_PER_LINE * sizeof(struct TraceRecord) * 2 + 2)
+#define DUMP_LOST_LENGTH  (2 + sizeof(uint32_t) * 2 + 2)
+
+static_assert((CONFIG_TRACE_SIZE & (CONFIG_TRACE_SIZE - 1)) == 0,
+    "Trace size should be a power of two");
+/*----------------------------------------------------------------------------*/
+static size_t printHex(char *, const uint8_t *, size_t);
+/*----------------------------------------------------------------------------*/
+static struct
+{
+  struct Timer *timer;
+  struct TraceRecord records[CONFIG_TRACE_SIZE];
+
+  /* Overwritten records since the last dump */
+  uint32_t lost;
+  /* Free running indices */
+  uint32_t head;
+  uint32_t tail;
+} trace = {
+    .timer = NULL
+};
+/*----------------------------------------------------------------------------*/
+static size_t printHex(char *text, const uint8_t *data, size_t length)
+{
+  static const char symbols[] = "0123456789ABCDEF";
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    *text++ = symbols[data[i] >> 4];
+    *text++ = symbols[data[i] & 0x0F];
+  }
+
+  return length * 2;
+}
+/*----------------------------------------------------------------------------*/
+void traceDump(struct Interface *serial)
+{
+  char text[DUMP_LINE_LENGTH];
+
+  while (1)
+  {
+    struct TraceRecord records[DUMP_RECORDS_PER_LINE];
+    size_t available;
+    size_t count = 0;
+    uint32_t lost;
+
+    if (ifGetParam(serial, IF_TX_AVAILABLE, &available) != E_OK)
+      return;
+    if (available < DUMP_LINE_LENGTH + DUMP_LOST_LENGTH)
+      return;
+
+    const IrqState state = irqSave();
+
+    lost = trace.lost;
+    trace.lost = 0;
+
+    while (count < DUMP_RECORDS_PER_LINE && trace.tail != trace.head)
+    {
+      records[count++] = trace.records[trace.tail % CONFIG_TRACE_SIZE];
+      ++trace.tail;
+    }
+
+    irqRestore(state);
+
+    if (lost)
+    {
+      size_t length = 0;
+
+      text[length++] = 'L';
+      text[length++] = ':';
+      length += printHex(text + length, (const uint8_t *)&lost, sizeof(lost));
+      text[length++] = '\r';
+      text[length++] = '\n';
+      ifWrite(serial, text, length);
+    }
+
+    if (!count)
+      break;
+
+    size_t length = 0;
+
+    text[length++] = 'T';
+    text[length++] = ':';
+    length += printHex(text + length, (const uint8_t *)records,
+        count * sizeof(struct TraceRecord));
+    text[length++] = '\r';
+    text[length++] = '\n';
+    ifWrite(serial, text, length);
+  }
+}
+/*----------------------------------------------------------------------------*/
+void traceInit(struct Timer *timer)
+{
+  trace.timer = timer;
+  trace.head = 0;
+  trace.tail = 0;
+  trace.lost = 0;
+}
+/*----------------------------------------------------------------------------*/
+bool traceReady(void)
+{
+  return trace.head - trace.tail >= DUMP_RECORDS_PER_LINE || trace.lost;
+}
+/*----------------------------------------------------------------------------*/
+void traceRecord(uint8_t event, uint8_t argument)
+{
+  if (trace.timer == NULL)
+    return;
+
+  const uint32_t timestamp = timerGetValue(trace.timer);
+  const IrqState state = irqSave();
+
+  if (trace.head - trace.tail == CONFIG_TRACE_SIZE)
+  {
+    ++trace.tail;
+    ++trace.lost;
+  }
+
+  trace.records[trace.head % CONFIG_TRACE_SIZE] = (struct TraceRecord){
+      .timestamp = timestamp,
+      .event = event,
+      .argument = argument
+  };
+  ++trace.head;
+
+  irqRestore(state);
+}
@@ -0,0 +1,47 @@
+/*
+ * trace.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef CORE_TRACE_H_
+#define CORE_TRACE_H_
+/*----------------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+#ifndef CONFIG_TRACE_SIZE
+#  define CONFIG_TRACE_SIZE 64
+#endif
+
+struct Interface;
+struct Timer;
+
+struct [[gnu::packed]] TraceRecord
+{
+  /* Value of the timestamp timer */
+  uint32_t timestamp;
+  /* Application-specific event identifier */
+  uint8_t event;
+  /* Event argument */
+  uint8_t argument;
+};
+/*----------------------------------------------------------------------------*/
+/*
+ * Records are dumped as text lines: "T:" prefix with up to eight records
+ * in hexadecimal form or "L:" prefix with a count of overwritten records.
+ */
+void traceDump(struct Interface *);
+void traceInit(struct Timer *);
+/* Returns true when a full line of records or a loss report is buffered */
+bool traceReady(void);
+void traceRecord(uint8_t, uint8_t);
+/*----------------------------------------------------------------------------*/
+#ifdef ENABLE_TRACE
+#  define TRACE(event, argument)  traceRecord((event), (argument))
+#else
+#  define TRACE(event, argument)  do {} while (0)
+#endif
+/*----------------------------------------------------------------------------*/
+#endif /* CORE_TRACE_H_ */
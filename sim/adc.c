@@ -0,0 +1,132 @@
+/*
+ * sim/adc.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/adc.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+struct SimAdc
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  enum AdcEvent event;
+  uint16_t sample;
+  bool enabled;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result adcInit(void *, const void *);
+static void adcSetCallback(void *, void (*)(void *), void *);
+static enum Result adcGetParam(void *, int, void *);
+static enum Result adcSetParam(void *, int, const void *);
+static size_t adcRead(void *, void *, size_t);
+static size_t adcWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const Adc = &(const struct InterfaceClass){
+    .size = sizeof(struct SimAdc),
+    .init = adcInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = adcSetCallback,
+    .getParam = adcGetParam,
+    .setParam = adcSetParam,
+    .read = adcRead,
+    .write = adcWrite
+};
+/*----------------------------------------------------------------------------*/
+static struct SimAdc *instance = NULL;
+static uint16_t inputValue = 0;
+/*----------------------------------------------------------------------------*/
+static enum Result adcInit(void *object, const void *arguments)
+{
+  const struct AdcConfig * const config = arguments;
+  struct SimAdc * const interface = object;
+
+  interface->callback = NULL;
+  interface->event = config->event;
+  interface->sample = 0;
+  interface->enabled = false;
+
+  instance = interface;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void adcSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimAdc * const interface = object;
+
+  interface->argument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result adcGetParam(void *, int parameter, void *)
+{
+  switch (parameter)
+  {
+    case IF_STATUS:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result adcSetParam(void *object, int parameter, const void *)
+{
+  struct SimAdc * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_DISABLE:
+      interface->enabled = false;
+      return E_OK;
+
+    case IF_ENABLE:
+      interface->enabled = true;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t adcRead(void *object, void *buffer, size_t length)
+{
+  const struct SimAdc * const interface = object;
+
+  if (length < sizeof(interface->sample))
+    return 0;
+
+  memcpy(buffer, &interface->sample, sizeof(interface->sample));
+  return sizeof(interface->sample);
+}
+/*----------------------------------------------------------------------------*/
+static size_t adcWrite(void *, const void *, size_t)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+void simAdcSetValue(uint16_t value)
+{
+  inputValue = value;
+}
+/*----------------------------------------------------------------------------*/
+void simAdcTrigger(void)
+{
+  if (instance == NULL || !instance->enabled
+      || instance->event != ADC_CT32B0_MAT0)
+  {
+    return;
+  }
+
+  instance->sample = inputValue;
+
+  if (instance->callback != NULL)
+    instance->callback(instance->argument);
+}
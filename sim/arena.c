@@ -0,0 +1,46 @@
+/*
+ * sim/arena.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+void arenaSeal(void);
+
+void *__real_calloc(size_t, size_t);
+void *__real_malloc(size_t);
+void *__wrap_calloc(size_t, size_t);
+void *__wrap_malloc(size_t);
+
+static void checkSealed(size_t);
+/*----------------------------------------------------------------------------*/
+static bool sealed = false;
+/*----------------------------------------------------------------------------*/
+static void checkSealed(size_t size)
+{
+  /* Firmware image is considered broken when it allocates after startup */
+  if (sealed)
+  {
+    fprintf(stderr, "sim: allocation of %zu bytes after arena seal\n", size);
+    exit(EXIT_FAILURE);
+  }
+}
+/*----------------------------------------------------------------------------*/
+void arenaSeal(void)
+{
+  sealed = true;
+}
+/*----------------------------------------------------------------------------*/
+void *__wrap_calloc(size_t number, size_t size)
+{
+  checkSealed(number * size);
+  return __real_calloc(number, size);
+}
+/*----------------------------------------------------------------------------*/
+void *__wrap_malloc(size_t size)
+{
+  checkSealed(size);
+  return __real_malloc(size);
+}
@@ -0,0 +1,174 @@
+/*
+ * sim/clocking.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include <halm/platform/lpc/clocking.h>
+/*----------------------------------------------------------------------------*/
+#define INT_OSC_FREQUENCY 12000000
+#define WDT_OSC_FREQUENCY 600000
+/*----------------------------------------------------------------------------*/
+struct SimClockClass
+{
+  struct ClockClass base;
+
+  /* Index of the clock state */
+  unsigned int index;
+};
+
+enum
+{
+  CLOCK_EXT_OSC,
+  CLOCK_INT_OSC,
+  CLOCK_WDT_OSC,
+  CLOCK_OUTPUT,
+  CLOCK_MAIN_INDEX,
+  CLOCK_WDT_INDEX,
+  CLOCK_COUNT
+};
+
+struct ClockState
+{
+  uint32_t frequency;
+  bool enabled;
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t sourceFrequency(enum ClockSource);
+
+static void clkDisable(const void *);
+static enum Result clkEnable(const void *, const void *);
+static uint32_t clkFrequency(const void *);
+static bool clkReady(const void *);
+
+static enum Result clockOutputEnable(const void *, const void *);
+static enum Result extOscEnable(const void *, const void *);
+static enum Result genericEnable(const void *, const void *);
+static enum Result wdtOscEnable(const void *, const void *);
+/*----------------------------------------------------------------------------*/
+#define CLOCK_CLASS(id, handler) \
+    &(const struct SimClockClass){ \
+        .base = { \
+            .enable = (handler), \
+            .disable = clkDisable, \
+            .frequency = clkFrequency, \
+            .ready = clkReady \
+        }, \
+        .index = (id) \
+    }.base
+
+const struct ClockClass * const ExternalOsc =
+    CLOCK_CLASS(CLOCK_EXT_OSC, extOscEnable);
+const struct ClockClass * const InternalOsc =
+    CLOCK_CLASS(CLOCK_INT_OSC, clkEnable);
+const struct ClockClass * const WdtOsc =
+    CLOCK_CLASS(CLOCK_WDT_OSC, wdtOscEnable);
+const struct ClockClass * const ClockOutput =
+    CLOCK_CLASS(CLOCK_OUTPUT, clockOutputEnable);
+const struct ClockClass * const MainClock =
+    CLOCK_CLASS(CLOCK_MAIN_INDEX, genericEnable);
+const struct ClockClass * const WdtClock =
+    CLOCK_CLASS(CLOCK_WDT_INDEX, genericEnable);
+/*----------------------------------------------------------------------------*/
+static struct ClockState clocks[CLOCK_COUNT] = {
+    [CLOCK_INT_OSC] = {INT_OSC_FREQUENCY, true},
+    [CLOCK_MAIN_INDEX] = {INT_OSC_FREQUENCY, true}
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t sourceFrequency(enum ClockSource source)
+{
+  switch (source)
+  {
+    case CLOCK_INTERNAL:
+      return clocks[CLOCK_INT_OSC].frequency;
+
+    case CLOCK_EXTERNAL:
+      return clocks[CLOCK_EXT_OSC].enabled ?
+          clocks[CLOCK_EXT_OSC].frequency : 0;
+
+    case CLOCK_WDT:
+      return clocks[CLOCK_WDT_OSC].enabled ?
+          clocks[CLOCK_WDT_OSC].frequency : 0;
+
+    case CLOCK_MAIN:
+      return clocks[CLOCK_MAIN_INDEX].frequency;
+
+    default:
+      return 0;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void clkDisable(const void *clock)
+{
+  const struct SimClockClass * const type = clock;
+  clocks[type->index].enabled = false;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result clkEnable(const void *clock, const void *)
+{
+  const struct SimClockClass * const type = clock;
+
+  clocks[type->index].enabled = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t clkFrequency(const void *clock)
+{
+  const struct SimClockClass * const type = clock;
+  return clocks[type->index].enabled ? clocks[type->index].frequency : 0;
+}
+/*----------------------------------------------------------------------------*/
+static bool clkReady(const void *clock)
+{
+  const struct SimClockClass * const type = clock;
+  return clocks[type->index].enabled;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result clockOutputEnable(const void *clock, const void *arguments)
+{
+  const struct ClockOutputConfig * const config = arguments;
+  const struct SimClockClass * const type = clock;
+  const uint32_t divisor = config->divisor ? config->divisor : 1;
+  const uint32_t frequency = sourceFrequency(config->source);
+
+  if (!frequency)
+    return E_ERROR;
+
+  clocks[type->index].frequency = frequency / divisor;
+  clocks[type->index].enabled = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result extOscEnable(const void *clock, const void *arguments)
+{
+  const struct ExternalOscConfig * const config = arguments;
+  const struct SimClockClass * const type = clock;
+
+  clocks[type->index].frequency = config->frequency;
+  clocks[type->index].enabled = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result genericEnable(const void *clock, const void *arguments)
+{
+  const struct GenericClockConfig * const config = arguments;
+  const struct SimClockClass * const type = clock;
+  const uint32_t divisor = config->divisor ? config->divisor : 1;
+  const uint32_t frequency = sourceFrequency(config->source);
+
+  if (!frequency)
+    return E_ERROR;
+
+  clocks[type->index].frequency = frequency / divisor;
+  clocks[type->index].enabled = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wdtOscEnable(const void *clock, const void *)
+{
+  const struct SimClockClass * const type = clock;
+
+  clocks[type->index].frequency = WDT_OSC_FREQUENCY;
+  clocks[type->index].enabled = true;
+  return E_OK;
+}
@@ -0,0 +1,155 @@
+/*
+ * sim/flash.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/flash.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define FLASH_SIZE    (32 * 1024)
+#define PAGE_SIZE     256
+#define SECTOR_SIZE   4096
+
+/* Typical IAP timings of the LPC11xx family, in microseconds */
+#define ERASE_TIME    100000
+#define PROGRAM_TIME  1000
+/*----------------------------------------------------------------------------*/
+struct SimFlash
+{
+  struct Interface base;
+
+  uint32_t position;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result flashInit(void *, const void *);
+static enum Result flashGetParam(void *, int, void *);
+static enum Result flashSetParam(void *, int, const void *);
+static size_t flashRead(void *, void *, size_t);
+static size_t flashWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const Flash = &(const struct InterfaceClass){
+    .size = sizeof(struct SimFlash),
+    .init = flashInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = NULL,
+    .getParam = flashGetParam,
+    .setParam = flashSetParam,
+    .read = flashRead,
+    .write = flashWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint8_t memory[FLASH_SIZE];
+static bool memoryReady = false;
+/*----------------------------------------------------------------------------*/
+static enum Result flashInit(void *object, const void *)
+{
+  struct SimFlash * const interface = object;
+
+  if (!memoryReady)
+  {
+    memset(memory, 0xFF, sizeof(memory));
+    memoryReady = true;
+  }
+
+  interface->position = 0;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flashGetParam(void *object, int parameter, void *data)
+{
+  struct SimFlash * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = interface->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = FLASH_SIZE;
+      return E_OK;
+
+    case IF_STATUS:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flashSetParam(void *object, int parameter, const void *data)
+{
+  struct SimFlash * const interface = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const uint32_t address = *(const uint32_t *)data;
+
+      if (address >= FLASH_SIZE || address % SECTOR_SIZE)
+        return E_ADDRESS;
+
+      memset(memory + address, 0xFF, SECTOR_SIZE);
+      ++simStats()->flashErases;
+      simConsume(ERASE_TIME);
+      return E_OK;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      if (position >= FLASH_SIZE)
+        return E_ADDRESS;
+
+      interface->position = position;
+      return E_OK;
+    }
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t flashRead(void *object, void *buffer, size_t length)
+{
+  struct SimFlash * const interface = object;
+
+  if (length > FLASH_SIZE - interface->position)
+    length = FLASH_SIZE - interface->position;
+
+  memcpy(buffer, memory + interface->position, length);
+  interface->position += length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t flashWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimFlash * const interface = object;
+  const uint8_t *input = buffer;
+
+  if (interface->position % PAGE_SIZE || length % PAGE_SIZE)
+    return 0;
+  if (length > FLASH_SIZE - interface->position)
+    return 0;
+
+  /* Programming is able to clear bits only */
+  for (size_t i = 0; i < length; ++i)
+    memory[interface->position + i] &= input[i];
+
+  interface->position += length;
+  simStats()->flashPrograms += length / PAGE_SIZE;
+  simConsume(PROGRAM_TIME * (length / PAGE_SIZE));
+
+  return length;
+}
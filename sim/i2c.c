@@ -0,0 +1,218 @@
+/*
+ * sim/i2c.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/i2c.h>
+/*----------------------------------------------------------------------------*/
+struct SimI2C
+{
+  struct Interface base;
+  struct SimClient client;
+
+  void (*callback)(void *);
+  void *argument;
+
+  /* Data rate in bits per second */
+  uint32_t rate;
+  /* Status of the last transfer */
+  enum Result status;
+  /* Address of the slave device */
+  uint8_t address;
+  /* Transfers complete asynchronously */
+  bool zerocopy;
+};
+/*----------------------------------------------------------------------------*/
+static struct SimI2CDevice *findDevice(uint8_t);
+static void onTransferCompleted(struct SimClient *);
+static size_t transfer(struct SimI2C *, size_t, size_t);
+
+static enum Result i2cInit(void *, const void *);
+static void i2cSetCallback(void *, void (*)(void *), void *);
+static enum Result i2cGetParam(void *, int, void *);
+static enum Result i2cSetParam(void *, int, const void *);
+static size_t i2cRead(void *, void *, size_t);
+static size_t i2cWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const I2C = &(const struct InterfaceClass){
+    .size = sizeof(struct SimI2C),
+    .init = i2cInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = i2cSetCallback,
+    .getParam = i2cGetParam,
+    .setParam = i2cSetParam,
+    .read = i2cRead,
+    .write = i2cWrite
+};
+/*----------------------------------------------------------------------------*/
+static struct SimI2CDevice *devices = NULL;
+/*----------------------------------------------------------------------------*/
+static struct SimI2CDevice *findDevice(uint8_t address)
+{
+  for (struct SimI2CDevice *device = devices; device != NULL;
+      device = device->next)
+  {
+    if (device->address == address)
+      return device;
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static void onTransferCompleted(struct SimClient *client)
+{
+  struct SimI2C * const interface =
+      (struct SimI2C *)((uintptr_t)client - offsetof(struct SimI2C, client));
+
+  client->deadline = SIM_NEVER;
+
+  if (interface->callback != NULL)
+    interface->callback(interface->argument);
+}
+/*----------------------------------------------------------------------------*/
+static size_t transfer(struct SimI2C *interface, size_t requested,
+    size_t transferred)
+{
+  struct SimStats * const stats = simStats();
+
+  /* Start condition, address byte, payload with acknowledge bits, stop */
+  const uint64_t bits = 2 + 9 * (1 + (uint64_t)transferred);
+  const uint32_t duration =
+      (uint32_t)((bits * 1000000 + interface->rate - 1) / interface->rate);
+
+  ++stats->i2cTransfers;
+  stats->i2cBytes += (uint32_t)transferred;
+  stats->i2cTime += duration;
+
+  interface->status = transferred == requested ? E_OK : E_ERROR;
+
+  if (interface->zerocopy)
+  {
+    interface->client.deadline = simTime() + duration;
+    return requested;
+  }
+  else
+  {
+    simConsume(duration);
+    return transferred;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result i2cInit(void *object, const void *arguments)
+{
+  const struct I2CConfig * const config = arguments;
+  struct SimI2C * const interface = object;
+
+  interface->client.fire = onTransferCompleted;
+  interface->client.deadline = SIM_NEVER;
+  interface->callback = NULL;
+  interface->rate = config->rate;
+  interface->status = E_OK;
+  interface->address = 0;
+  interface->zerocopy = false;
+
+  simAttach(&interface->client);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void i2cSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimI2C * const interface = object;
+
+  interface->argument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result i2cGetParam(void *object, int parameter, void *data)
+{
+  struct SimI2C * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_ADDRESS:
+      *(uint32_t *)data = interface->address;
+      return E_OK;
+
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      return E_OK;
+
+    case IF_STATUS:
+      return interface->client.deadline != SIM_NEVER ?
+          E_BUSY : interface->status;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result i2cSetParam(void *object, int parameter, const void *data)
+{
+  struct SimI2C * const interface = object;
+
+  switch ((enum I2CParameter)parameter)
+  {
+    case IF_I2C_BUS_RECOVERY:
+    case IF_I2C_REPEATED_START:
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_ACQUIRE:
+    case IF_RELEASE:
+      return E_OK;
+
+    case IF_ADDRESS:
+      interface->address = (uint8_t)*(const uint32_t *)data;
+      return E_OK;
+
+    case IF_BLOCKING:
+      interface->zerocopy = false;
+      return E_OK;
+
+    case IF_RATE:
+      interface->rate = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      interface->zerocopy = true;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t i2cRead(void *object, void *buffer, size_t length)
+{
+  struct SimI2C * const interface = object;
+  struct SimI2CDevice * const device = findDevice(interface->address);
+  const size_t count = device != NULL ?
+      device->read(device, buffer, length) : 0;
+
+  return transfer(interface, length, count);
+}
+/*----------------------------------------------------------------------------*/
+static size_t i2cWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimI2C * const interface = object;
+  struct SimI2CDevice * const device = findDevice(interface->address);
+  const size_t count = device != NULL ?
+      device->write(device, buffer, length) : 0;
+
+  return transfer(interface, length, count);
+}
+/*----------------------------------------------------------------------------*/
+void simI2CAttach(struct SimI2CDevice *device)
+{
+  device->next = devices;
+  devices = device;
+}
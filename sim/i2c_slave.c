@@ -0,0 +1,183 @@
+/*
+ * sim/i2c_slave.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/i2c_slave.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+struct SimI2CSlave
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  uint8_t *cache;
+  size_t size;
+  uint32_t address;
+  uint32_t position;
+};
+/*----------------------------------------------------------------------------*/
+static void notifyFirmware(struct SimI2CSlave *);
+
+static enum Result slaveInit(void *, const void *);
+static void slaveSetCallback(void *, void (*)(void *), void *);
+static enum Result slaveGetParam(void *, int, void *);
+static enum Result slaveSetParam(void *, int, const void *);
+static size_t slaveRead(void *, void *, size_t);
+static size_t slaveWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const I2CSlave = &(const struct InterfaceClass){
+    .size = sizeof(struct SimI2CSlave),
+    .init = slaveInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = slaveSetCallback,
+    .getParam = slaveGetParam,
+    .setParam = slaveSetParam,
+    .read = slaveRead,
+    .write = slaveWrite
+};
+/*----------------------------------------------------------------------------*/
+static struct SimI2CSlave *instance = NULL;
+/*----------------------------------------------------------------------------*/
+static void notifyFirmware(struct SimI2CSlave *interface)
+{
+  if (interface->callback != NULL)
+  {
+    ++simStats()->wakeups;
+    interface->callback(interface->argument);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result slaveInit(void *object, const void *arguments)
+{
+  const struct I2CSlaveConfig * const config = arguments;
+  struct SimI2CSlave * const interface = object;
+
+  interface->cache = malloc(config->size);
+  if (interface->cache == NULL)
+    return E_MEMORY;
+  memset(interface->cache, 0, config->size);
+
+  interface->callback = NULL;
+  interface->size = config->size;
+  interface->address = 0;
+  interface->position = 0;
+
+  instance = interface;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void slaveSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimI2CSlave * const interface = object;
+
+  interface->argument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result slaveGetParam(void *object, int parameter, void *data)
+{
+  struct SimI2CSlave * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_ADDRESS:
+      *(uint32_t *)data = interface->address;
+      return E_OK;
+
+    case IF_POSITION:
+      *(uint32_t *)data = interface->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = (uint32_t)interface->size;
+      return E_OK;
+
+    case IF_STATUS:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result slaveSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct SimI2CSlave * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_ADDRESS:
+      interface->address = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_POSITION:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      if (position >= interface->size)
+        return E_ADDRESS;
+
+      interface->position = position;
+      return E_OK;
+    }
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t slaveRead(void *object, void *buffer, size_t length)
+{
+  struct SimI2CSlave * const interface = object;
+  const size_t available = interface->size - interface->position;
+
+  if (length > available)
+    length = available;
+
+  memcpy(buffer, interface->cache + interface->position, length);
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t slaveWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimI2CSlave * const interface = object;
+  const size_t available = interface->size - interface->position;
+
+  if (length > available)
+    length = available;
+
+  memcpy(interface->cache + interface->position, buffer, length);
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+bool simSlaveRead(size_t position, void *buffer, size_t length)
+{
+  if (instance == NULL || position + length > instance->size)
+    return false;
+
+  /* Register pointer is set by a write transaction before the read */
+  notifyFirmware(instance);
+
+  memcpy(buffer, instance->cache + position, length);
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+bool simSlaveWrite(size_t position, const void *buffer, size_t length)
+{
+  if (instance == NULL || position + length > instance->size)
+    return false;
+
+  memcpy(instance->cache + position, buffer, length);
+  notifyFirmware(instance);
+
+  return true;
+}
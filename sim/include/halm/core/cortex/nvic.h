@@ -0,0 +1,18 @@
+/*
+ * sim/include/halm/core/cortex/nvic.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_CORE_CORTEX_NVIC_H_
+#define HALM_CORE_CORTEX_NVIC_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void nvicResetCore(void);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_CORE_CORTEX_NVIC_H_ */
@@ -0,0 +1,20 @@
+/*
+ * sim/include/halm/core/cortex/systick.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_CORE_CORTEX_SYSTICK_H_
+#define HALM_CORE_CORTEX_SYSTICK_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/timer.h>
+/*----------------------------------------------------------------------------*/
+extern const struct TimerClass * const SysTick;
+
+struct SysTickConfig
+{
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_CORE_CORTEX_SYSTICK_H_ */
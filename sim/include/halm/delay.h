@@ -0,0 +1,20 @@
+/*
+ * sim/include/halm/delay.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_DELAY_H_
+#define HALM_DELAY_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void mdelay(uint32_t);
+void udelay(uint32_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_DELAY_H_ */
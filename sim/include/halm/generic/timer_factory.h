@@ -0,0 +1,28 @@
+/*
+ * sim/include/halm/generic/timer_factory.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_GENERIC_TIMER_FACTORY_H_
+#define HALM_GENERIC_TIMER_FACTORY_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/timer.h>
+/*----------------------------------------------------------------------------*/
+extern const struct EntityClass * const TimerFactory;
+
+struct TimerFactory;
+
+struct TimerFactoryConfig
+{
+  /** Mandatory: base timer. */
+  struct Timer *timer;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+struct Timer *timerFactoryCreate(struct TimerFactory *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_TIMER_FACTORY_H_ */
@@ -0,0 +1,21 @@
+/*
+ * sim/include/halm/generic/work_queue.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_GENERIC_WORK_QUEUE_H_
+#define HALM_GENERIC_WORK_QUEUE_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/wq.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+extern const struct WqClass * const WorkQueue;
+
+struct WorkQueueConfig
+{
+  /** Mandatory: maximum number of pending tasks. */
+  size_t size;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_WORK_QUEUE_H_ */
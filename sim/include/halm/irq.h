@@ -0,0 +1,24 @@
+/*
+ * sim/include/halm/irq.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_IRQ_H_
+#define HALM_IRQ_H_
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+typedef uint32_t IrqState;
+/*----------------------------------------------------------------------------*/
+/* Simulated interrupts are never preemptive, masking is not required */
+static inline IrqState irqSave(void)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static inline void irqRestore(IrqState)
+{
+}
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_IRQ_H_ */
@@ -0,0 +1,71 @@
+/*
+ * sim/include/halm/pin.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PIN_H_
+#define HALM_PIN_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+typedef uint16_t PinNumber;
+
+#define PIN(port, offset) \
+    ((PinNumber)((((port) & 0xFF) << 8) | ((offset) & 0xFF)))
+#define PIN_TO_PORT(key)                ((uint8_t)((key) >> 8))
+#define PIN_TO_OFFSET(key)              ((uint8_t)(key))
+
+#define SIM_PIN_PORTS                   4
+#define SIM_PIN_OFFSETS                 12
+
+enum InputEvent
+{
+  INPUT_RISING,
+  INPUT_FALLING,
+  INPUT_TOGGLE,
+  INPUT_HIGH,
+  INPUT_LOW
+};
+
+enum PinPull
+{
+  PIN_NOPULL,
+  PIN_PULLUP,
+  PIN_PULLDOWN
+};
+
+struct Pin
+{
+  PinNumber key;
+  bool valid;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+struct Pin pinInit(PinNumber);
+void pinInput(struct Pin);
+void pinOutput(struct Pin, bool);
+void pinSetPull(struct Pin, enum PinPull);
+
+bool pinRead(struct Pin);
+void pinWrite(struct Pin, bool);
+void pinReset(struct Pin);
+void pinSet(struct Pin);
+void pinToggle(struct Pin);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+static inline struct Pin pinStub(void)
+{
+  return (struct Pin){0, false};
+}
+/*----------------------------------------------------------------------------*/
+static inline bool pinValid(struct Pin pin)
+{
+  return pin.valid;
+}
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PIN_H_ */
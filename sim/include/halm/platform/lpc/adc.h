@@ -0,0 +1,40 @@
+/*
+ * sim/include/halm/platform/lpc/adc.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_ADC_H_
+#define HALM_PLATFORM_LPC_ADC_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/pin.h>
+#include <xcore/interface.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const Adc;
+
+enum AdcEvent
+{
+  ADC_SOFTWARE,
+  ADC_CT16B0_MAT0,
+  ADC_CT16B0_MAT1,
+  ADC_CT16B1_MAT0,
+  ADC_CT16B1_MAT1,
+  ADC_CT32B0_MAT0,
+  ADC_CT32B0_MAT1,
+  ADC_CT32B1_MAT0,
+  ADC_CT32B1_MAT1
+};
+
+struct AdcConfig
+{
+  /** Mandatory: pointer to an array of pins terminated by a zero element. */
+  const PinNumber *pins;
+  /** Mandatory: hardware trigger event. */
+  enum AdcEvent event;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: peripheral identifier. */
+  uint8_t channel;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_ADC_H_ */
@@ -0,0 +1,20 @@
+/*
+ * sim/include/halm/platform/lpc/backup_domain.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_BACKUP_DOMAIN_H_
+#define HALM_PLATFORM_LPC_BACKUP_DOMAIN_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void *backupDomainAddress(void);
+size_t backupDomainSize(void);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_BACKUP_DOMAIN_H_ */
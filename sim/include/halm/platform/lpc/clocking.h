@@ -0,0 +1,97 @@
+/*
+ * sim/include/halm/platform/lpc/clocking.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_CLOCKING_H_
+#define HALM_PLATFORM_LPC_CLOCKING_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/pin.h>
+#include <xcore/error.h>
+/*----------------------------------------------------------------------------*/
+enum ClockSource
+{
+  CLOCK_INTERNAL,
+  CLOCK_EXTERNAL,
+  CLOCK_PLL,
+  CLOCK_WDT,
+  CLOCK_MAIN
+};
+
+enum WdtFrequency
+{
+  WDT_FREQ_600,
+  WDT_FREQ_1050,
+  WDT_FREQ_1400,
+  WDT_FREQ_1750
+};
+
+struct ClockOutputConfig
+{
+  /** Optional: input clock divisor. */
+  uint32_t divisor;
+  /** Mandatory: output pin. */
+  PinNumber pin;
+  /** Mandatory: clock source. */
+  enum ClockSource source;
+};
+
+struct ExternalOscConfig
+{
+  /** Mandatory: frequency of the external crystal oscillator. */
+  uint32_t frequency;
+  /** Optional: enable bypass. */
+  bool bypass;
+};
+
+struct GenericClockConfig
+{
+  /** Optional: input clock divisor. */
+  uint32_t divisor;
+  /** Mandatory: clock source. */
+  enum ClockSource source;
+};
+
+struct WdtOscConfig
+{
+  /** Optional: frequency of the watchdog oscillator. */
+  enum WdtFrequency frequency;
+};
+
+struct ClockClass
+{
+  enum Result (*enable)(const void *, const void *);
+  void (*disable)(const void *);
+  uint32_t (*frequency)(const void *);
+  bool (*ready)(const void *);
+};
+/*----------------------------------------------------------------------------*/
+extern const struct ClockClass * const ExternalOsc;
+extern const struct ClockClass * const InternalOsc;
+extern const struct ClockClass * const WdtOsc;
+extern const struct ClockClass * const ClockOutput;
+extern const struct ClockClass * const MainClock;
+extern const struct ClockClass * const WdtClock;
+/*----------------------------------------------------------------------------*/
+static inline void clockDisable(const void *clock)
+{
+  ((const struct ClockClass *)clock)->disable(clock);
+}
+
+static inline enum Result clockEnable(const void *clock, const void *config)
+{
+  return ((const struct ClockClass *)clock)->enable(clock, config);
+}
+
+static inline uint32_t clockFrequency(const void *clock)
+{
+  return ((const struct ClockClass *)clock)->frequency(clock);
+}
+
+static inline bool clockReady(const void *clock)
+{
+  return ((const struct ClockClass *)clock)->ready(clock);
+}
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_CLOCKING_H_ */
@@ -0,0 +1,14 @@
+/*
+ * sim/include/halm/platform/lpc/flash.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_FLASH_H_
+#define HALM_PLATFORM_LPC_FLASH_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/flash.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const Flash;
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_FLASH_H_ */
@@ -0,0 +1,32 @@
+/*
+ * sim/include/halm/platform/lpc/gptimer.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_GPTIMER_H_
+#define HALM_PLATFORM_LPC_GPTIMER_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/timer.h>
+/*----------------------------------------------------------------------------*/
+extern const struct TimerClass * const GpTimer;
+
+enum
+{
+  GPTIMER_CT16B0,
+  GPTIMER_CT16B1,
+  GPTIMER_CT32B0,
+  GPTIMER_CT32B1
+};
+
+struct GpTimerConfig
+{
+  /** Optional: timer frequency. */
+  uint32_t frequency;
+  /** Optional: timer interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: timer block. */
+  uint8_t channel;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_GPTIMER_H_ */
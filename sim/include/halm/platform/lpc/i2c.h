@@ -0,0 +1,29 @@
+/*
+ * sim/include/halm/platform/lpc/i2c.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_I2C_H_
+#define HALM_PLATFORM_LPC_I2C_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/i2c.h>
+#include <halm/pin.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const I2C;
+
+struct I2CConfig
+{
+  /** Mandatory: data rate. */
+  uint32_t rate;
+  /** Mandatory: serial clock pin. */
+  PinNumber scl;
+  /** Mandatory: serial data pin. */
+  PinNumber sda;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: peripheral identifier. */
+  uint8_t channel;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_I2C_H_ */
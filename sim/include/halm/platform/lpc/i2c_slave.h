@@ -0,0 +1,29 @@
+/*
+ * sim/include/halm/platform/lpc/i2c_slave.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_I2C_SLAVE_H_
+#define HALM_PLATFORM_LPC_I2C_SLAVE_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/i2c.h>
+#include <halm/pin.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const I2CSlave;
+
+struct I2CSlaveConfig
+{
+  /** Mandatory: size of the internal buffer. */
+  size_t size;
+  /** Mandatory: serial clock pin. */
+  PinNumber scl;
+  /** Mandatory: serial data pin. */
+  PinNumber sda;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: peripheral identifier. */
+  uint8_t channel;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_I2C_SLAVE_H_ */
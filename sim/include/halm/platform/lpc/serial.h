@@ -0,0 +1,33 @@
+/*
+ * sim/include/halm/platform/lpc/serial.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_SERIAL_H_
+#define HALM_PLATFORM_LPC_SERIAL_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/pin.h>
+#include <xcore/interface.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const Serial;
+
+struct SerialConfig
+{
+  /** Mandatory: input queue size. */
+  size_t rxLength;
+  /** Mandatory: output queue size. */
+  size_t txLength;
+  /** Mandatory: baud rate. */
+  uint32_t rate;
+  /** Optional: serial data input. */
+  PinNumber rx;
+  /** Optional: serial data output. */
+  PinNumber tx;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: peripheral identifier. */
+  uint8_t channel;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_SERIAL_H_ */
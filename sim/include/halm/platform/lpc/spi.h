@@ -0,0 +1,33 @@
+/*
+ * sim/include/halm/platform/lpc/spi.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_SPI_H_
+#define HALM_PLATFORM_LPC_SPI_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/spi.h>
+#include <halm/pin.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const Spi;
+
+struct SpiConfig
+{
+  /** Mandatory: serial data rate. */
+  uint32_t rate;
+  /** Optional: serial data input. */
+  PinNumber miso;
+  /** Optional: serial data output. */
+  PinNumber mosi;
+  /** Mandatory: serial clock output. */
+  PinNumber sck;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: peripheral identifier. */
+  uint8_t channel;
+  /** Optional: mode number. */
+  uint8_t mode;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_SPI_H_ */
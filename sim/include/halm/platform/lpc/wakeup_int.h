@@ -0,0 +1,27 @@
+/*
+ * sim/include/halm/platform/lpc/wakeup_int.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_WAKEUP_INT_H_
+#define HALM_PLATFORM_LPC_WAKEUP_INT_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/interrupt.h>
+#include <halm/pin.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterruptClass * const WakeupInt;
+
+struct WakeupIntConfig
+{
+  /** Mandatory: pin used as a wake-up source. */
+  PinNumber pin;
+  /** Optional: interrupt priority. */
+  uint8_t priority;
+  /** Mandatory: edge sensitivity mode. */
+  enum InputEvent event;
+  /** Optional: enables pull-up or pull-down resistors. */
+  enum PinPull pull;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_WAKEUP_INT_H_ */
@@ -0,0 +1,20 @@
+/*
+ * sim/include/halm/platform/lpc/wdt.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PLATFORM_LPC_WDT_H_
+#define HALM_PLATFORM_LPC_WDT_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/watchdog.h>
+/*----------------------------------------------------------------------------*/
+extern const struct WatchdogClass * const Wdt;
+
+struct WdtConfig
+{
+  /** Mandatory: timer period in milliseconds. */
+  uint32_t period;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_LPC_WDT_H_ */
@@ -0,0 +1,27 @@
+/*
+ * sim/include/halm/pm.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef HALM_PM_H_
+#define HALM_PM_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+/*----------------------------------------------------------------------------*/
+enum PmState
+{
+  PM_ACTIVE,
+  PM_SLEEP,
+  PM_SUSPEND,
+  PM_SHUTDOWN
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+enum Result pmChangeState(enum PmState);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PM_H_ */
@@ -0,0 +1,96 @@
+/*
+ * sim/include/sim.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/pin.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+#define SIM_NEVER UINT64_MAX
+
+/* Event source driven by the simulated time base */
+struct SimClient
+{
+  struct SimClient *next;
+  void (*fire)(struct SimClient *);
+
+  /* Absolute time of the next event in microseconds */
+  uint64_t deadline;
+};
+
+/* Device connected to the simulated I2C master */
+struct SimI2CDevice
+{
+  struct SimI2CDevice *next;
+
+  size_t (*read)(struct SimI2CDevice *, void *, size_t);
+  size_t (*write)(struct SimI2CDevice *, const void *, size_t);
+
+  /* 7-bit device address */
+  uint8_t address;
+};
+
+struct SimStats
+{
+  /* Interrupts and timer events that woke the core */
+  uint32_t wakeups;
+  /* Work queue tasks executed */
+  uint32_t tasks;
+  /* Rejected work queue requests */
+  uint32_t rejected;
+  /* Maximum number of pending work queue tasks */
+  uint32_t watermark;
+  /* Transfers and payload on the I2C master bus */
+  uint32_t i2cTransfers;
+  uint32_t i2cBytes;
+  /* Time the I2C master bus was occupied, in microseconds */
+  uint32_t i2cTime;
+  /* Transfers and payload on the SPI bus */
+  uint32_t spiTransfers;
+  uint32_t spiBytes;
+  /* Flash operations */
+  uint32_t flashErases;
+  uint32_t flashPrograms;
+  /* Time spent in blocking operations, in microseconds */
+  uint32_t busyTime;
+  /* Transitions into low-power states */
+  uint32_t suspends;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/* Time base */
+void simAdvance(uint64_t);
+void simAttach(struct SimClient *);
+void simConsume(uint32_t);
+uint64_t simTime(void);
+
+/* Statistics */
+struct SimStats *simStats(void);
+void simResetStats(void);
+
+/* Work queue */
+size_t simDrain(void);
+
+/* Pins */
+void simPinDrive(PinNumber, bool);
+bool simPinLevel(PinNumber);
+void simPinRelease(PinNumber);
+void simPinSubscribe(PinNumber, void (*)(void *, bool), void *);
+
+/* Peripherals */
+void simAdcSetValue(uint16_t);
+void simAdcTrigger(void);
+void simI2CAttach(struct SimI2CDevice *);
+bool simSlaveRead(size_t, void *, size_t);
+bool simSlaveWrite(size_t, const void *, size_t);
+void simSpiSetHandler(uint8_t (*)(void *, uint8_t), void *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* SIM_H_ */
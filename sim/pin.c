@@ -0,0 +1,284 @@
+/*
+ * sim/pin.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/pin_int.h>
+#include <halm/platform/lpc/wakeup_int.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define MAX_SUBSCRIBERS 8
+/*----------------------------------------------------------------------------*/
+struct PinState
+{
+  enum PinPull pull;
+
+  /* Level driven by the external circuit */
+  bool external;
+  /* External circuit drives the pin */
+  bool driven;
+  /* Output latch */
+  bool latch;
+  /* Pin is configured as an output */
+  bool output;
+};
+
+struct PinSubscriber
+{
+  void (*callback)(void *, bool);
+  void *argument;
+  PinNumber key;
+};
+
+struct SimPinInt
+{
+  struct Interrupt base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  PinNumber key;
+  enum InputEvent event;
+  bool enabled;
+};
+/*----------------------------------------------------------------------------*/
+static struct PinState *getState(PinNumber);
+static bool getLevel(const struct PinState *);
+static void notifySubscribers(PinNumber, bool);
+static void onPinEvent(void *, bool);
+
+static enum Result pinIntInit(void *, const void *);
+static enum Result wakeupIntInit(void *, const void *);
+static void intEnable(void *);
+static void intDisable(void *);
+static void intSetCallback(void *, void (*)(void *), void *);
+/*----------------------------------------------------------------------------*/
+const struct InterruptClass * const PinInt =
+    &(const struct InterruptClass){
+    .size = sizeof(struct SimPinInt),
+    .init = pinIntInit,
+    .deinit = NULL, /* Default destructor */
+
+    .enable = intEnable,
+    .disable = intDisable,
+    .setCallback = intSetCallback
+};
+
+const struct InterruptClass * const WakeupInt =
+    &(const struct InterruptClass){
+    .size = sizeof(struct SimPinInt),
+    .init = wakeupIntInit,
+    .deinit = NULL, /* Default destructor */
+
+    .enable = intEnable,
+    .disable = intDisable,
+    .setCallback = intSetCallback
+};
+/*----------------------------------------------------------------------------*/
+static struct PinState pins[SIM_PIN_PORTS][SIM_PIN_OFFSETS] = {0};
+static struct PinSubscriber subscribers[MAX_SUBSCRIBERS] = {0};
+static size_t subscriberCount = 0;
+/*----------------------------------------------------------------------------*/
+static struct PinState *getState(PinNumber key)
+{
+  const unsigned int port = PIN_TO_PORT(key);
+  const unsigned int offset = PIN_TO_OFFSET(key);
+
+  assert(port < SIM_PIN_PORTS && offset < SIM_PIN_OFFSETS);
+  return &pins[port][offset];
+}
+/*----------------------------------------------------------------------------*/
+static bool getLevel(const struct PinState *state)
+{
+  if (state->output)
+    return state->latch;
+  if (state->driven)
+    return state->external;
+
+  return state->pull != PIN_PULLDOWN;
+}
+/*----------------------------------------------------------------------------*/
+static void notifySubscribers(PinNumber key, bool level)
+{
+  for (size_t i = 0; i < subscriberCount; ++i)
+  {
+    if (subscribers[i].key == key)
+      subscribers[i].callback(subscribers[i].argument, level);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void onPinEvent(void *argument, bool level)
+{
+  struct SimPinInt * const interrupt = argument;
+
+  if (!interrupt->enabled || interrupt->callback == NULL)
+    return;
+
+  switch (interrupt->event)
+  {
+    case INPUT_RISING:
+    case INPUT_HIGH:
+      if (!level)
+        return;
+      break;
+
+    case INPUT_FALLING:
+    case INPUT_LOW:
+      if (level)
+        return;
+      break;
+
+    default:
+      break;
+  }
+
+  ++simStats()->wakeups;
+  interrupt->callback(interrupt->argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pinIntInit(void *object, const void *arguments)
+{
+  const struct PinIntConfig * const config = arguments;
+  struct SimPinInt * const interrupt = object;
+
+  interrupt->callback = NULL;
+  interrupt->key = config->pin;
+  interrupt->event = config->event;
+  interrupt->enabled = false;
+
+  const struct Pin pin = pinInit(config->pin);
+  pinInput(pin);
+  pinSetPull(pin, config->pull);
+
+  simPinSubscribe(config->pin, onPinEvent, interrupt);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wakeupIntInit(void *object, const void *arguments)
+{
+  const struct WakeupIntConfig * const config = arguments;
+
+  return pinIntInit(object, &(const struct PinIntConfig){
+      .pin = config->pin,
+      .priority = config->priority,
+      .event = config->event,
+      .pull = config->pull
+  });
+}
+/*----------------------------------------------------------------------------*/
+static void intEnable(void *object)
+{
+  ((struct SimPinInt *)object)->enabled = true;
+}
+/*----------------------------------------------------------------------------*/
+static void intDisable(void *object)
+{
+  ((struct SimPinInt *)object)->enabled = false;
+}
+/*----------------------------------------------------------------------------*/
+static void intSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimPinInt * const interrupt = object;
+
+  interrupt->argument = argument;
+  interrupt->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+struct Pin pinInit(PinNumber key)
+{
+  getState(key);
+  return (struct Pin){key, true};
+}
+/*----------------------------------------------------------------------------*/
+void pinInput(struct Pin pin)
+{
+  getState(pin.key)->output = false;
+}
+/*----------------------------------------------------------------------------*/
+void pinOutput(struct Pin pin, bool value)
+{
+  struct PinState * const state = getState(pin.key);
+
+  state->latch = value;
+  state->output = true;
+}
+/*----------------------------------------------------------------------------*/
+void pinSetPull(struct Pin pin, enum PinPull pull)
+{
+  getState(pin.key)->pull = pull;
+}
+/*----------------------------------------------------------------------------*/
+bool pinRead(struct Pin pin)
+{
+  return pin.valid ? getLevel(getState(pin.key)) : false;
+}
+/*----------------------------------------------------------------------------*/
+void pinWrite(struct Pin pin, bool value)
+{
+  if (pin.valid)
+    getState(pin.key)->latch = value;
+}
+/*----------------------------------------------------------------------------*/
+void pinReset(struct Pin pin)
+{
+  pinWrite(pin, false);
+}
+/*----------------------------------------------------------------------------*/
+void pinSet(struct Pin pin)
+{
+  pinWrite(pin, true);
+}
+/*----------------------------------------------------------------------------*/
+void pinToggle(struct Pin pin)
+{
+  if (pin.valid)
+  {
+    struct PinState * const state = getState(pin.key);
+    state->latch = !state->latch;
+  }
+}
+/*----------------------------------------------------------------------------*/
+void simPinDrive(PinNumber key, bool level)
+{
+  struct PinState * const state = getState(key);
+  const bool previous = getLevel(state);
+
+  state->external = level;
+  state->driven = true;
+
+  if (!state->output && previous != level)
+    notifySubscribers(key, level);
+}
+/*----------------------------------------------------------------------------*/
+bool simPinLevel(PinNumber key)
+{
+  return getLevel(getState(key));
+}
+/*----------------------------------------------------------------------------*/
+void simPinRelease(PinNumber key)
+{
+  struct PinState * const state = getState(key);
+  const bool previous = getLevel(state);
+
+  state->driven = false;
+
+  const bool level = getLevel(state);
+
+  if (!state->output && previous != level)
+    notifySubscribers(key, level);
+}
+/*----------------------------------------------------------------------------*/
+void simPinSubscribe(PinNumber key, void (*callback)(void *, bool),
+    void *argument)
+{
+  assert(subscriberCount < MAX_SUBSCRIBERS);
+
+  subscribers[subscriberCount++] = (struct PinSubscriber){
+      callback,
+      argument,
+      key
+  };
+}
@@ -0,0 +1,114 @@
+/*
+ * sim/serial.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include <halm/platform/lpc/serial.h>
+#include <stdio.h>
+/*----------------------------------------------------------------------------*/
+struct SimSerial
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  uint32_t rate;
+  size_t txLength;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result serialInit(void *, const void *);
+static void serialSetCallback(void *, void (*)(void *), void *);
+static enum Result serialGetParam(void *, int, void *);
+static enum Result serialSetParam(void *, int, const void *);
+static size_t serialRead(void *, void *, size_t);
+static size_t serialWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const Serial = &(const struct InterfaceClass){
+    .size = sizeof(struct SimSerial),
+    .init = serialInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = serialSetCallback,
+    .getParam = serialGetParam,
+    .setParam = serialSetParam,
+    .read = serialRead,
+    .write = serialWrite
+};
+/*----------------------------------------------------------------------------*/
+static enum Result serialInit(void *object, const void *arguments)
+{
+  const struct SerialConfig * const config = arguments;
+  struct SimSerial * const interface = object;
+
+  interface->callback = NULL;
+  interface->rate = config->rate;
+  interface->txLength = config->txLength;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void serialSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimSerial * const interface = object;
+
+  interface->argument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result serialGetParam(void *object, int parameter, void *data)
+{
+  struct SimSerial * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      return E_OK;
+
+    case IF_RX_AVAILABLE:
+    case IF_TX_PENDING:
+      *(size_t *)data = 0;
+      return E_OK;
+
+    case IF_TX_AVAILABLE:
+      /* Output is flushed immediately */
+      *(size_t *)data = interface->txLength;
+      return E_OK;
+
+    case IF_STATUS:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result serialSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct SimSerial * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_RATE:
+      interface->rate = *(const uint32_t *)data;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t serialRead(void *, void *, size_t)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static size_t serialWrite(void *, const void *buffer, size_t length)
+{
+  /* Debug output is forwarded to the standard error stream */
+  return fwrite(buffer, 1, length, stderr);
+}
@@ -0,0 +1,130 @@
+/*
+ * sim/sim.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/core/cortex/nvic.h>
+#include <halm/delay.h>
+#include <halm/platform/lpc/backup_domain.h>
+#include <halm/pm.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define BACKUP_SIZE 20
+/*----------------------------------------------------------------------------*/
+static struct SimClient *findNextClient(uint64_t);
+/*----------------------------------------------------------------------------*/
+static struct
+{
+  struct SimClient *clients;
+  struct SimStats stats;
+  uint64_t time;
+
+  uint32_t backup[BACKUP_SIZE / sizeof(uint32_t)];
+} sim = {0};
+/*----------------------------------------------------------------------------*/
+static struct SimClient *findNextClient(uint64_t limit)
+{
+  struct SimClient *next = NULL;
+
+  for (struct SimClient *client = sim.clients; client != NULL;
+      client = client->next)
+  {
+    if (client->deadline <= limit
+        && (next == NULL || client->deadline < next->deadline))
+    {
+      next = client;
+    }
+  }
+
+  return next;
+}
+/*----------------------------------------------------------------------------*/
+void simAdvance(uint64_t period)
+{
+  const uint64_t end = sim.time + period;
+  struct SimClient *client;
+
+  /* Process work produced by the stimulus applied before this step */
+  simDrain();
+
+  while ((client = findNextClient(end)) != NULL)
+  {
+    /* Late events are fired immediately after the blocking operation */
+    if (client->deadline > sim.time)
+      sim.time = client->deadline;
+
+    ++sim.stats.wakeups;
+    client->fire(client);
+    simDrain();
+  }
+
+  if (sim.time < end)
+    sim.time = end;
+}
+/*----------------------------------------------------------------------------*/
+void simAttach(struct SimClient *client)
+{
+  client->next = sim.clients;
+  sim.clients = client;
+}
+/*----------------------------------------------------------------------------*/
+void simConsume(uint32_t period)
+{
+  sim.time += period;
+  sim.stats.busyTime += period;
+}
+/*----------------------------------------------------------------------------*/
+uint64_t simTime(void)
+{
+  return sim.time;
+}
+/*----------------------------------------------------------------------------*/
+struct SimStats *simStats(void)
+{
+  return &sim.stats;
+}
+/*----------------------------------------------------------------------------*/
+void simResetStats(void)
+{
+  memset(&sim.stats, 0, sizeof(sim.stats));
+}
+/*----------------------------------------------------------------------------*/
+void *backupDomainAddress(void)
+{
+  return sim.backup;
+}
+/*----------------------------------------------------------------------------*/
+size_t backupDomainSize(void)
+{
+  return sizeof(sim.backup);
+}
+/*----------------------------------------------------------------------------*/
+void mdelay(uint32_t period)
+{
+  simConsume(period * 1000);
+}
+/*----------------------------------------------------------------------------*/
+void udelay(uint32_t period)
+{
+  simConsume(period);
+}
+/*----------------------------------------------------------------------------*/
+void nvicResetCore(void)
+{
+  fprintf(stderr, "sim: core reset requested at %llu us\n",
+      (unsigned long long)sim.time);
+  exit(EXIT_FAILURE);
+}
+/*----------------------------------------------------------------------------*/
+enum Result pmChangeState(enum PmState state)
+{
+  /* Wake-up sources are not modelled, the core returns immediately */
+  if (state == PM_SUSPEND || state == PM_SHUTDOWN)
+    ++sim.stats.suspends;
+
+  return E_OK;
+}
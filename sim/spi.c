@@ -0,0 +1,141 @@
+/*
+ * sim/spi.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/spi.h>
+/*----------------------------------------------------------------------------*/
+struct SimSpi
+{
+  struct Interface base;
+
+  uint32_t rate;
+  bool unidir;
+};
+/*----------------------------------------------------------------------------*/
+static uint8_t exchange(struct SimSpi *, uint8_t);
+
+static enum Result spiInit(void *, const void *);
+static enum Result spiGetParam(void *, int, void *);
+static enum Result spiSetParam(void *, int, const void *);
+static size_t spiRead(void *, void *, size_t);
+static size_t spiWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const Spi = &(const struct InterfaceClass){
+    .size = sizeof(struct SimSpi),
+    .init = spiInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = NULL,
+    .getParam = spiGetParam,
+    .setParam = spiSetParam,
+    .read = spiRead,
+    .write = spiWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint8_t (*handler)(void *, uint8_t) = NULL;
+static void *handlerArgument = NULL;
+/*----------------------------------------------------------------------------*/
+static uint8_t exchange(struct SimSpi *interface, uint8_t value)
+{
+  /* Eight clock cycles per byte */
+  simConsume((8 * 1000000 + interface->rate - 1) / interface->rate);
+  simStats()->spiBytes += 1;
+
+  return handler != NULL ? handler(handlerArgument, value) : 0xFF;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result spiInit(void *object, const void *arguments)
+{
+  const struct SpiConfig * const config = arguments;
+  struct SimSpi * const interface = object;
+
+  interface->rate = config->rate;
+  interface->unidir = true;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result spiGetParam(void *object, int parameter, void *data)
+{
+  struct SimSpi * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      return E_OK;
+
+    case IF_STATUS:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result spiSetParam(void *object, int parameter, const void *data)
+{
+  struct SimSpi * const interface = object;
+
+  switch ((enum SPIParameter)parameter)
+  {
+    case IF_SPI_BIDIRECTIONAL:
+      interface->unidir = false;
+      return E_OK;
+
+    case IF_SPI_UNIDIRECTIONAL:
+      interface->unidir = true;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RATE:
+      interface->rate = *(const uint32_t *)data;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t spiRead(void *object, void *buffer, size_t length)
+{
+  struct SimSpi * const interface = object;
+  uint8_t *position = buffer;
+
+  ++simStats()->spiTransfers;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    /* Buffer content is transmitted in bidirectional mode */
+    position[i] = exchange(interface, interface->unidir ? 0xFF : position[i]);
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t spiWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimSpi * const interface = object;
+  const uint8_t *position = buffer;
+
+  ++simStats()->spiTransfers;
+
+  for (size_t i = 0; i < length; ++i)
+    exchange(interface, position[i]);
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+void simSpiSetHandler(uint8_t (*callback)(void *, uint8_t), void *argument)
+{
+  handler = callback;
+  handlerArgument = argument;
+}
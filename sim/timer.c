@@ -0,0 +1,384 @@
+/*
+ * sim/timer.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/core/cortex/systick.h>
+#include <halm/generic/timer_factory.h>
+#include <halm/platform/lpc/clocking.h>
+#include <halm/platform/lpc/gptimer.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define SYSTICK_CHANNEL 0xFF
+/*----------------------------------------------------------------------------*/
+struct SimTimer
+{
+  struct Timer base;
+  struct SimClient client;
+
+  void (*callback)(void *);
+  void *argument;
+
+  /* Time of the last counter reload */
+  uint64_t epoch;
+  /* Timer frequency, zero means core clock frequency */
+  uint32_t frequency;
+  /* Period in timer ticks, zero means full 32-bit range */
+  uint32_t overflow;
+
+  uint8_t channel;
+  bool enabled;
+};
+
+struct SimFactoryTimer
+{
+  struct Timer base;
+
+  struct SimFactoryTimer *next;
+  struct SimTimerFactory *factory;
+
+  void (*callback)(void *);
+  void *argument;
+
+  uint32_t overflow;
+  uint32_t value;
+  bool enabled;
+};
+
+struct SimTimerFactory
+{
+  struct Entity base;
+
+  struct Timer *timer;
+  struct SimFactoryTimer *timers;
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t getPeriod(const struct SimTimer *);
+static void onTimerEvent(struct SimClient *);
+static void restartTimer(struct SimTimer *);
+
+static enum Result gpTimerInit(void *, const void *);
+static enum Result sysTickInit(void *, const void *);
+static void tmrEnable(void *);
+static void tmrDisable(void *);
+static void tmrSetCallback(void *, void (*)(void *), void *);
+static uint32_t tmrGetFrequency(const void *);
+static void tmrSetFrequency(void *, uint32_t);
+static uint32_t tmrGetOverflow(const void *);
+static void tmrSetOverflow(void *, uint32_t);
+static uint32_t tmrGetValue(const void *);
+static void tmrSetValue(void *, uint32_t);
+
+static void onBaseTick(void *);
+static enum Result factoryInit(void *, const void *);
+
+static enum Result ftmrInit(void *, const void *);
+static void ftmrEnable(void *);
+static void ftmrDisable(void *);
+static void ftmrSetCallback(void *, void (*)(void *), void *);
+static uint32_t ftmrGetFrequency(const void *);
+static uint32_t ftmrGetOverflow(const void *);
+static void ftmrSetOverflow(void *, uint32_t);
+static uint32_t ftmrGetValue(const void *);
+static void ftmrSetValue(void *, uint32_t);
+/*----------------------------------------------------------------------------*/
+const struct TimerClass * const GpTimer = &(const struct TimerClass){
+    .size = sizeof(struct SimTimer),
+    .init = gpTimerInit,
+    .deinit = NULL, /* Default destructor */
+
+    .enable = tmrEnable,
+    .disable = tmrDisable,
+    .setCallback = tmrSetCallback,
+    .getFrequency = tmrGetFrequency,
+    .setFrequency = tmrSetFrequency,
+    .getOverflow = tmrGetOverflow,
+    .setOverflow = tmrSetOverflow,
+    .getValue = tmrGetValue,
+    .setValue = tmrSetValue
+};
+
+const struct TimerClass * const SysTick = &(const struct TimerClass){
+    .size = sizeof(struct SimTimer),
+    .init = sysTickInit,
+    .deinit = NULL, /* Default destructor */
+
+    .enable = tmrEnable,
+    .disable = tmrDisable,
+    .setCallback = tmrSetCallback,
+    .getFrequency = tmrGetFrequency,
+    .setFrequency = tmrSetFrequency,
+    .getOverflow = tmrGetOverflow,
+    .setOverflow = tmrSetOverflow,
+    .getValue = tmrGetValue,
+    .setValue = tmrSetValue
+};
+
+const struct EntityClass * const TimerFactory = &(const struct EntityClass){
+    .size = sizeof(struct SimTimerFactory),
+    .init = factoryInit,
+    .deinit = NULL /* Default destructor */
+};
+
+static const struct TimerClass * const FactoryTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct SimFactoryTimer),
+    .init = ftmrInit,
+    .deinit = NULL, /* Default destructor */
+
+    .enable = ftmrEnable,
+    .disable = ftmrDisable,
+    .setCallback = ftmrSetCallback,
+    .getFrequency = ftmrGetFrequency,
+    .getOverflow = ftmrGetOverflow,
+    .setOverflow = ftmrSetOverflow,
+    .getValue = ftmrGetValue,
+    .setValue = ftmrSetValue
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t getPeriod(const struct SimTimer *timer)
+{
+  const uint64_t ticks = timer->overflow ? timer->overflow : (1ULL << 32);
+  const uint64_t frequency = tmrGetFrequency(timer);
+
+  /* Period in microseconds, at least one microsecond */
+  const uint64_t period = frequency ? ticks * 1000000 / frequency : 0;
+  return period ? period : 1;
+}
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(struct SimClient *client)
+{
+  struct SimTimer * const timer =
+      (struct SimTimer *)((uintptr_t)client - offsetof(struct SimTimer, client));
+
+  timer->epoch = client->deadline;
+  client->deadline = timer->epoch + getPeriod(timer);
+
+  /* Match output of the CT32B0 triggers ADC conversion */
+  if (timer->channel == GPTIMER_CT32B0)
+    simAdcTrigger();
+
+  if (timer->callback != NULL)
+    timer->callback(timer->argument);
+}
+/*----------------------------------------------------------------------------*/
+static void restartTimer(struct SimTimer *timer)
+{
+  timer->epoch = simTime();
+  timer->client.deadline = timer->enabled ?
+      timer->epoch + getPeriod(timer) : SIM_NEVER;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result gpTimerInit(void *object, const void *arguments)
+{
+  const struct GpTimerConfig * const config = arguments;
+  struct SimTimer * const timer = object;
+
+  timer->client.fire = onTimerEvent;
+  timer->client.deadline = SIM_NEVER;
+  timer->callback = NULL;
+  timer->epoch = 0;
+  timer->frequency = config->frequency;
+  timer->overflow = 0;
+  timer->channel = config->channel;
+  timer->enabled = false;
+
+  simAttach(&timer->client);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result sysTickInit(void *object, const void *)
+{
+  struct SimTimer * const timer = object;
+
+  timer->client.fire = onTimerEvent;
+  timer->client.deadline = SIM_NEVER;
+  timer->callback = NULL;
+  timer->epoch = 0;
+  timer->frequency = 0;
+  timer->overflow = 1UL << 24;
+  timer->channel = SYSTICK_CHANNEL;
+  timer->enabled = false;
+
+  simAttach(&timer->client);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrEnable(void *object)
+{
+  struct SimTimer * const timer = object;
+
+  timer->enabled = true;
+  restartTimer(timer);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDisable(void *object)
+{
+  struct SimTimer * const timer = object;
+
+  timer->enabled = false;
+  timer->client.deadline = SIM_NEVER;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimTimer * const timer = object;
+
+  timer->argument = argument;
+  timer->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetFrequency(const void *object)
+{
+  const struct SimTimer * const timer = object;
+  return timer->frequency ? timer->frequency : clockFrequency(MainClock);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetFrequency(void *object, uint32_t frequency)
+{
+  struct SimTimer * const timer = object;
+
+  timer->frequency = frequency;
+  restartTimer(timer);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetOverflow(const void *object)
+{
+  return ((const struct SimTimer *)object)->overflow;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetOverflow(void *object, uint32_t overflow)
+{
+  struct SimTimer * const timer = object;
+
+  timer->overflow = overflow;
+  restartTimer(timer);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetValue(const void *object)
+{
+  const struct SimTimer * const timer = object;
+  const uint64_t ticks = (simTime() - timer->epoch)
+      * tmrGetFrequency(timer) / 1000000;
+
+  return timer->overflow ? (uint32_t)(ticks % timer->overflow) :
+      (uint32_t)ticks;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue(void *object, uint32_t value)
+{
+  struct SimTimer * const timer = object;
+  const uint64_t offset = (uint64_t)value * 1000000 / tmrGetFrequency(timer);
+
+  timer->epoch = simTime() - offset;
+
+  if (timer->enabled)
+    timer->client.deadline = timer->epoch + getPeriod(timer);
+}
+/*----------------------------------------------------------------------------*/
+static void onBaseTick(void *argument)
+{
+  struct SimTimerFactory * const factory = argument;
+
+  for (struct SimFactoryTimer *timer = factory->timers; timer != NULL;
+      timer = timer->next)
+  {
+    if (!timer->enabled || !timer->overflow)
+      continue;
+
+    if (++timer->value >= timer->overflow)
+    {
+      timer->value = 0;
+
+      if (timer->callback != NULL)
+        timer->callback(timer->argument);
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result factoryInit(void *object, const void *arguments)
+{
+  const struct TimerFactoryConfig * const config = arguments;
+  struct SimTimerFactory * const factory = object;
+
+  factory->timer = config->timer;
+  factory->timers = NULL;
+
+  timerSetCallback(factory->timer, onBaseTick, factory);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result ftmrInit(void *object, const void *arguments)
+{
+  struct SimFactoryTimer * const timer = object;
+  struct SimTimerFactory * const factory = (struct SimTimerFactory *)arguments;
+
+  timer->factory = factory;
+  timer->callback = NULL;
+  timer->overflow = 0;
+  timer->value = 0;
+  timer->enabled = false;
+
+  timer->next = factory->timers;
+  factory->timers = timer;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void ftmrEnable(void *object)
+{
+  ((struct SimFactoryTimer *)object)->enabled = true;
+}
+/*----------------------------------------------------------------------------*/
+static void ftmrDisable(void *object)
+{
+  ((struct SimFactoryTimer *)object)->enabled = false;
+}
+/*----------------------------------------------------------------------------*/
+static void ftmrSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimFactoryTimer * const timer = object;
+
+  timer->argument = argument;
+  timer->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t ftmrGetFrequency(const void *object)
+{
+  const struct SimFactoryTimer * const timer = object;
+  const uint32_t overflow = timerGetOverflow(timer->factory->timer);
+
+  return overflow ? timerGetFrequency(timer->factory->timer) / overflow : 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t ftmrGetOverflow(const void *object)
+{
+  return ((const struct SimFactoryTimer *)object)->overflow;
+}
+/*----------------------------------------------------------------------------*/
+static void ftmrSetOverflow(void *object, uint32_t overflow)
+{
+  struct SimFactoryTimer * const timer = object;
+
+  timer->overflow = overflow;
+  timer->value = 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t ftmrGetValue(const void *object)
+{
+  return ((const struct SimFactoryTimer *)object)->value;
+}
+/*----------------------------------------------------------------------------*/
+static void ftmrSetValue(void *object, uint32_t value)
+{
+  ((struct SimFactoryTimer *)object)->value = value;
+}
+/*----------------------------------------------------------------------------*/
+struct Timer *timerFactoryCreate(struct TimerFactory *factory)
+{
+  return init(FactoryTimer, factory);
+}
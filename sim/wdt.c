@@ -0,0 +1,59 @@
+/*
+ * sim/wdt.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/platform/lpc/wdt.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+struct SimWdt
+{
+  struct Watchdog base;
+  struct SimClient client;
+
+  /* Period in microseconds */
+  uint64_t period;
+};
+/*----------------------------------------------------------------------------*/
+static void onWatchdogExpired(struct SimClient *);
+
+static enum Result wdtInit(void *, const void *);
+static void wdtReload(void *);
+/*----------------------------------------------------------------------------*/
+const struct WatchdogClass * const Wdt = &(const struct WatchdogClass){
+    .size = sizeof(struct SimWdt),
+    .init = wdtInit,
+    .deinit = NULL, /* Default destructor */
+
+    .reload = wdtReload
+};
+/*----------------------------------------------------------------------------*/
+static void onWatchdogExpired(struct SimClient *)
+{
+  /* Firmware image is considered broken when the watchdog expires */
+  fprintf(stderr, "sim: watchdog expired at %llu us\n",
+      (unsigned long long)simTime());
+  exit(EXIT_FAILURE);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wdtInit(void *object, const void *arguments)
+{
+  const struct WdtConfig * const config = arguments;
+  struct SimWdt * const timer = object;
+
+  timer->period = (uint64_t)config->period * 1000;
+  timer->client.fire = onWatchdogExpired;
+  timer->client.deadline = simTime() + timer->period;
+
+  simAttach(&timer->client);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void wdtReload(void *object)
+{
+  struct SimWdt * const timer = object;
+  timer->client.deadline = simTime() + timer->period;
+}
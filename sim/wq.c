@@ -0,0 +1,134 @@
+/*
+ * sim/wq.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim.h"
+#include <halm/generic/work_queue.h>
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define MAX_TASKS_PER_DRAIN 100000
+/*----------------------------------------------------------------------------*/
+struct SimTask
+{
+  void (*callback)(void *);
+  void *argument;
+};
+
+struct SimWorkQueue
+{
+  struct Entity base;
+
+  struct SimTask *tasks;
+  size_t capacity;
+  size_t count;
+  size_t head;
+
+  /* Idle loop iterations since the last statistics request */
+  uint32_t loops;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result wqInit(void *, const void *);
+static enum Result wqPush(void *, void (*)(void *), void *);
+static void wqGetStatistics(void *, struct WqInfo *);
+static enum Result wqRun(void *);
+static void wqHalt(void *);
+/*----------------------------------------------------------------------------*/
+const struct WqClass * const WorkQueue = &(const struct WqClass){
+    .size = sizeof(struct SimWorkQueue),
+    .init = wqInit,
+    .deinit = NULL, /* Default destructor */
+
+    .add = wqPush,
+    .statistics = wqGetStatistics,
+    .start = wqRun,
+    .stop = wqHalt
+};
+/*----------------------------------------------------------------------------*/
+void *WQ_DEFAULT = NULL;
+/*----------------------------------------------------------------------------*/
+static enum Result wqInit(void *object, const void *arguments)
+{
+  const struct WorkQueueConfig * const config = arguments;
+  struct SimWorkQueue * const wq = object;
+
+  wq->tasks = malloc(sizeof(struct SimTask) * config->size);
+  if (wq->tasks == NULL)
+    return E_MEMORY;
+
+  wq->capacity = config->size;
+  wq->count = 0;
+  wq->head = 0;
+  wq->loops = 0;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wqPush(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimWorkQueue * const wq = object;
+  struct SimStats * const stats = simStats();
+
+  if (wq->count == wq->capacity)
+  {
+    ++stats->rejected;
+    return E_FULL;
+  }
+
+  wq->tasks[(wq->head + wq->count) % wq->capacity] =
+      (struct SimTask){callback, argument};
+  ++wq->count;
+
+  if (wq->count > stats->watermark)
+    stats->watermark = (uint32_t)wq->count;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void wqGetStatistics(void *object, struct WqInfo *info)
+{
+  struct SimWorkQueue * const wq = object;
+
+  info->loops = wq->loops;
+  wq->loops = 0;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wqRun(void *)
+{
+  /* Queue is processed by the simulated time base */
+  simDrain();
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void wqHalt(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+size_t simDrain(void)
+{
+  struct SimWorkQueue * const wq = WQ_DEFAULT;
+  size_t executed = 0;
+
+  if (wq == NULL)
+    return 0;
+
+  while (wq->count)
+  {
+    const struct SimTask task = wq->tasks[wq->head];
+
+    wq->head = (wq->head + 1) % wq->capacity;
+    --wq->count;
+
+    task.callback(task.argument);
+    ++simStats()->tasks;
+
+    /* Guard against tasks that reschedule themselves endlessly */
+    assert(++executed < MAX_TASKS_PER_DRAIN);
+  }
+
+  ++wq->loops;
+  return executed;
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# eq_generate.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+import argparse
+import cmath
+import math
+import os
+
+# Sample rates of the codec clock table
+RATES = (8000, 16000, 22050, 32000, 44100, 48000, 96000)
+
+# Presets in the order of the firmware enumeration without the flat preset,
+# each one has up to two sections: type, frequency in Hz, Q and gain in dB
+PRESETS = (
+    ('Bass', (('lowshelf', 120.0, 0.707, 6.0),)),
+    ('Voice', (('highpass', 150.0, 0.707, 0.0), ('peaking', 2500.0, 1.0, 4.0))),
+    ('Treble', (('highshelf', 6000.0, 0.707, 6.0),))
+)
+
+PASSTHROUGH = ((1.0, 0.0, 0.0), (1.0, 0.0, 0.0))
+
+def design(kind, frequency, q, gain, rate):
+    # Formulae from the Audio EQ Cookbook, frequency is kept below Nyquist
+    w0 = 2.0 * math.pi * min(frequency, rate * 0.45) / rate
+    cosw = math.cos(w0)
+    alpha = math.sin(w0) / (2.0 * q)
+    amp = 10.0 ** (gain / 40.0)
+    root = 2.0 * math.sqrt(amp) * alpha
+
+    if kind == 'highpass':
+        b = ((1.0 + cosw) / 2.0, -(1.0 + cosw), (1.0 + cosw) / 2.0)
+        a = (1.0 + alpha, -2.0 * cosw, 1.0 - alpha)
+    elif kind == 'peaking':
+        b = (1.0 + alpha * amp, -2.0 * cosw, 1.0 - alpha * amp)
+        a = (1.0 + alpha / amp, -2.0 * cosw, 1.0 - alpha / amp)
+    elif kind == 'lowshelf':
+        b = (amp * ((amp + 1.0) - (amp - 1.0) * cosw + root),
+             2.0 * amp * ((amp - 1.0) - (amp + 1.0) * cosw),
+             amp * ((amp + 1.0) - (amp - 1.0) * cosw - root))
+        a = ((amp + 1.0) + (amp - 1.0) * cosw + root,
+             -2.0 * ((amp - 1.0) + (amp + 1.0) * cosw),
+             (amp + 1.0) + (amp - 1.0) * cosw - root)
+    elif kind == 'highshelf':
+        b = (amp * ((amp + 1.0) + (amp - 1.0) * cosw + root),
+             -2.0 * amp * ((amp - 1.0) + (amp + 1.0) * cosw),
+             amp * ((amp + 1.0) + (amp - 1.0) * cosw - root))
+        a = ((amp + 1.0) - (amp - 1.0) * cosw + root,
+             2.0 * ((amp - 1.0) - (amp + 1.0) * cosw),
+             (amp + 1.0) - (amp - 1.0) * cosw - root)
+    else:
+        raise ValueError(f'unknown filter type {kind}')
+
+    return tuple(x / a[0] for x in b), tuple(x / a[0] for x in a)
+
+def peak_gain(sections, points=1024):
+    peak = 0.0
+    for index in range(points + 1):
+        z = cmath.exp(-1j * math.pi * index / points)
+        response = 1.0
+        for b, a in sections:
+            response *= (b[0] + b[1] * z + b[2] * z * z) / (a[0] + a[1] * z + a[2] * z * z)
+        peak = max(peak, abs(response))
+    return peak
+
+def quantize(value, scale):
+    result = round(value * scale)
+    # Unity coefficients are saturated, other overflows are design errors
+    if result < -32768 or result > 32768:
+        raise ValueError(f'coefficient {value} is out of range')
+    return min(result, 32767)
+
+def make_entry(filters, rate):
+    sections = [design(*parameters, rate) for parameters in filters]
+    sections += [PASSTHROUGH] * (2 - len(sections))
+
+    # Boosts are normalized to the unity peak gain to avoid clipping in the codec
+    for index, (b, a) in enumerate(sections):
+        peak = peak_gain([(b, a)])
+        if peak > 1.0:
+            sections[index] = (tuple(x / peak for x in b), a)
+
+    # Numerator N0, 2 * N1, N2 and denominator 32768, -2 * D1, -D2 in Q15
+    values = []
+    for b, _ in sections:
+        values += [quantize(b[0], 32768), quantize(b[1], 16384), quantize(b[2], 32768)]
+    for _, a in sections:
+        values += [quantize(-a[1], 16384), quantize(-a[2], 32768)]
+
+    data = []
+    for value in values:
+        data += [(value >> 8) & 0xFF, value & 0xFF]
+    return data
+
+def make_header(name):
+    lines = [
+        '/*',
+        f' * {name}',
+        ' * Generated by tools/eq_generate.py, do not edit',
+        ' */',
+        '',
+        '#ifndef CODEC_EQ_TABLE_H_',
+        '#define CODEC_EQ_TABLE_H_',
+        '/*' + '-' * 76 + '*/',
+        'static const uint32_t codecEqRates[] = {',
+        '    ' + ', '.join(str(rate) for rate in RATES),
+        '};',
+        '',
+        '/* Coefficients N0..N5, D1, D2, D4 and D5 as big-endian values */',
+        f'static const struct CodecEq codecEqTable[][{len(RATES)}] = {{'
+    ]
+
+    for preset, (title, filters) in enumerate(PRESETS):
+        lines += [f'    /* {title} */', '    {']
+        for index, rate in enumerate(RATES):
+            data = [f'0x{value:02X}' for value in make_entry(filters, rate)]
+            suffix = ',' if index < len(RATES) - 1 else ''
+            lines += [
+                f'        /* {rate} Hz */',
+                '        {{',
+                '            ' + ', '.join(data[:10]) + ',',
+                '            ' + ', '.join(data[10:]),
+                '        }}' + suffix
+            ]
+        lines.append('    }' + (',' if preset < len(PRESETS) - 1 else ''))
+
+    lines += [
+        '};',
+        '/*' + '-' * 76 + '*/',
+        '#endif /* CODEC_EQ_TABLE_H_ */',
+        ''
+    ]
+    return '\n'.join(lines)
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate biquad coefficients of codec EQ presets')
+    parser.add_argument('output', help='path to the generated header')
+    options = parser.parse_args()
+
+    with open(options.output, 'w', encoding='utf-8') as stream:
+        stream.write(make_header(os.path.basename(options.output)))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# trace_decode.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+DEFAULT_EVENTS = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                              'board', 'audioboard_v1', 'applications', 'active',
+                              'trace_events.h')
+RECORD = struct.Struct('<IBB')
+
+def load_names(path):
+    events, tasks = {}, {}
+    with open(path, 'r', encoding='utf-8') as stream:
+        for name, value in re.findall(r'\b((?:TRACE|TASK)_\w+)\s*=\s*(0x[0-9A-Fa-f]+|\d+)',
+                                      stream.read()):
+            table = events if name.startswith('TRACE_') else tasks
+            table[int(value, 0)] = name
+    return events, tasks
+
+def parse_records(stream, period):
+    # Timestamps are unwrapped assuming that consecutive records are less than one period apart
+    base, previous = 0, None
+    for line in stream:
+        line = line.strip()
+        if line.startswith('L:'):
+            yield ('lost', struct.unpack('<I', bytes.fromhex(line[2:10]))[0])
+        elif line[:2] in ('R:', 'W:'):
+            data = bytes.fromhex(line[2:])
+            buckets = struct.unpack(f'<{(len(data) - 1) // 2}H', data[1:])
+            yield ('run' if line[0] == 'R' else 'wait', (data[0], buckets))
+        elif line.startswith('T:'):
+            data = bytes.fromhex(line[2:])
+            for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+                timestamp, event, argument = RECORD.unpack_from(data, offset)
+                if previous is not None and timestamp < previous:
+                    base += period
+                previous = timestamp
+                yield ('record', (base + timestamp, event, argument))
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode event trace from the debug serial output')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('r'), default=sys.stdin,
+                        help='captured serial output, standard input by default')
+    parser.add_argument('--events', dest='events', default=DEFAULT_EVENTS,
+                        help='header with event and task identifiers')
+    parser.add_argument('--period', dest='period', type=int, default=1000000,
+                        help='timestamp timer period in ticks')
+    parser.add_argument('--latency', dest='latency', nargs=2, metavar=('FROM', 'TO'),
+                        help='measure intervals between two events, e.g. SLAVE_UPDATE LED_WRITE')
+    parser.add_argument('--quiet', dest='quiet', action='store_true', default=False,
+                        help='print summary only')
+    options = parser.parse_args()
+
+    events, tasks = load_names(options.events)
+    ids = {name: value for value, name in events.items()}
+    task_events = {ids.get(name) for name in ('TRACE_TASK_QUEUED', 'TRACE_TASK_REJECTED',
+                                              'TRACE_TASK_ENTER', 'TRACE_TASK_EXIT')}
+    durations = {}
+    entered = {}
+    intervals = []
+    histograms = {}
+    pending = None
+    lost = 0
+    last = None
+
+    latency = None
+    if options.latency is not None:
+        latency = [ids.get('TRACE_' + name.upper(), ids.get(name)) for name in options.latency]
+        if None in latency:
+            parser.error('unknown event in latency arguments')
+
+    for kind, value in parse_records(options.input, options.period):
+        if kind == 'lost':
+            lost += value
+            if not options.quiet:
+                print(f'{"":>12} {"":>8} lost {value} records')
+            continue
+        if kind in ('run', 'wait'):
+            # Counters are cumulative, the latest dump is kept
+            histograms[(value[0], kind)] = value[1]
+            continue
+
+        timestamp, event, argument = value
+        name = events.get(event, f'0x{event:02X}')
+
+        if event in task_events:
+            text = tasks.get(argument, f'0x{argument:02X}')
+        else:
+            text = f'0x{argument:02X}'
+
+        if event == ids.get('TRACE_TASK_ENTER'):
+            entered[argument] = timestamp
+        elif event == ids.get('TRACE_TASK_EXIT') and argument in entered:
+            durations.setdefault(argument, []).append(timestamp - entered.pop(argument))
+
+        if latency is not None:
+            if event == latency[0] and pending is None:
+                pending = timestamp
+            elif event == latency[1] and pending is not None:
+                intervals.append(timestamp - pending)
+                pending = None
+
+        if not options.quiet:
+            delta = timestamp - last if last is not None else 0
+            print(f'{timestamp:>12} {"+" + str(delta):>8} {name[6:] if name.startswith("TRACE_") else name} {text}')
+        last = timestamp
+
+    print(f'Lost records: {lost}')
+    for task, values in sorted(durations.items()):
+        print(f'{tasks.get(task, task)}: count {len(values)} min {min(values)} '
+              f'avg {sum(values) // len(values)} max {max(values)}')
+    for (task, kind), buckets in sorted(histograms.items()):
+        # Bucket N counts intervals from 2^N to 2^(N+1) - 1 ticks, the last one is unbounded
+        text = ' '.join(f'<{2 ** (index + 1)}:{count}' for index, count in enumerate(buckets[:-1])
+                        if count)
+        if buckets[-1]:
+            text += f' >={2 ** (len(buckets) - 1)}:{buckets[-1]}'
+        print(f'{tasks.get(task, task)} {kind}: {text.strip()}')
+    if latency is not None and intervals:
+        print(f'Latency {options.latency[0]} -> {options.latency[1]}: count {len(intervals)} '
+              f'min {min(intervals)} avg {sum(intervals) // len(intervals)} max {max(intervals)}')
+
+if __name__ == '__main__':
+    main()